@@ -1,10 +1,12 @@
 #include <iostream>
 #include <fstream>
 #include <chrono>
+#include <algorithm>
 #include "src/jssp.h"
 #include "src/ts.h"
 #include "src/mem.h"
 #include "src/heuristics.h"
+#include "src/bnb.h"
 
 using namespace std::chrono;
 
@@ -13,7 +15,8 @@ void memetic_bench(string instance_path, int time_limit, int lb, int seed) {
 
     JSSPInstance instance = JSSPInstance(instance_path, seed);
     MemeticAlgorithm mem = MemeticAlgorithm(instance);
-    BMResult result = mem.optimize(time_limit, lb);
+    auto start_solutions = Heuristics::population(instance, 30);
+    BMResult result = mem.optimizePopulation(time_limit, start_solutions, lb);
 
     long long total_time = duration_cast<seconds>(high_resolution_clock::now() - t0).count();
 
@@ -25,17 +28,19 @@ void memetic_bench(string instance_path, int time_limit, int lb, int seed) {
     }
     std::ofstream out_file;
     out_file.open ("memetic_bm.txt", std::ios::app);
-    out_file << instance_path << "\t" << "total time\t" << total_time << "s\t" << "makespan reached at\t" << time_to_msp << "s\t" << "makespan:\t" << result.makespan << "\n";
+    out_file << instance_path << "\t" << "total time\t" << total_time << "s\t" << "makespan reached at\t" << time_to_msp << "s\t" << "makespan:\t" << result.makespan
+             << "\t" << "lower bound:\t" << result.lowerBound << "\t" << "gap:\t" << result.gap << "\n";
     out_file.close();
 }
 
-void tabu_bench(string instance_path, int time_limit, int lb, int seed) {
+void tabu_bench(string instance_path, int time_limit, int lb, int seed, NeighbourhoodStructure neighbourhood) {
     auto t0 = high_resolution_clock::now();
 
     JSSPInstance instance = JSSPInstance(instance_path, seed);
-    TabuSearch ts = TabuSearch(instance);
-    auto heuristic_solution = Heuristics::random(instance);
-    auto starting_solution = Solution{heuristic_solution, instance.calcMakespan(heuristic_solution)};
+    TabuSearch ts = TabuSearch(instance, neighbourhood);
+    auto start_solutions = Heuristics::population(instance, dispatchingRuleCount + 1);
+    auto starting_solution = *std::min_element(start_solutions.begin(), start_solutions.end(),
+                                               [](Solution const &a, Solution const &b) { return a.makespan < b.makespan; });
     BMResult result = ts.optimize(starting_solution, time_limit, lb);
 
     long long total_time = duration_cast<seconds>(high_resolution_clock::now() - t0).count();
@@ -49,18 +54,36 @@ void tabu_bench(string instance_path, int time_limit, int lb, int seed) {
 
     std::ofstream out_file;
     out_file.open ("tabu_bm.txt", std::ios::app);
-    out_file << instance_path << "\t" << "total time\t" << total_time << "s\t" << "makespan reached at\t" << time_to_msp << "s\t" << "makespan:\t" << result.makespan << "\n";
+    auto const &statistics = ts.statistics();
+    out_file << instance_path << "\t" << "N" << neighbourhood + 5 << "\t" << "total time\t" << total_time << "s\t" << "makespan reached at\t" << time_to_msp << "s\t" << "makespan:\t" << result.makespan
+             << "\t" << "lower bound:\t" << result.lowerBound << "\t" << "gap:\t" << result.gap
+             << "\t" << "perturbations:\t" << statistics.perturbations << "\t" << "restarts:\t" << statistics.restarts << "\n";
     out_file.close();
 }
 
-int main() {
+// optimum of a small instance (up to 100 operations) proven by branch and bound within 10 s, 0 otherwise. Passed to
+// the algorithms as lower bound, so they stop when they reach it
+int proven_optimum(string instance_path) {
+    JSSPInstance instance = JSSPInstance(instance_path, 1);
+    if (instance.operationCount() > 100) return 0;
+    auto result = BranchAndBound(instance).solve(0, 10);
+    return result.optimal ? result.solution.makespan : 0;
+}
+
+// usage: benchmark [n5|n6|n7] - neighbourhood structure of the tabu search, default n7
+int main(int argc, char *argv[]) {
+    NeighbourhoodStructure neighbourhood = n7;
+    if (argc > 1 && string(argv[1]) == "n5") neighbourhood = n5;
+    if (argc > 1 && string(argv[1]) == "n6") neighbourhood = n6;
+
     vector<string> instances = {"../instances/abz_instances/abz5.txt", "../instances/abz_instances/abz6.txt", "../instances/abz_instances/abz7.txt", "../instances/abz_instances/abz8.txt"
     ,"../instances/abz_instances/abz9.txt", "../instances/ft_instances/ft06.txt", "../instances/ft_instances/ft10.txt", "../instances/ft_instances/ft20.txt", "../instances/swv_instances/swv01.txt", "../instances/swv_instances/swv02.txt", "../instances/swv_instances/swv03.txt", "../instances/swv_instances/swv04.txt", "../instances/swv_instances/swv05.txt", "../instances/swv_instances/swv06.txt", "../instances/swv_instances/swv07.txt", "../instances/swv_instances/swv08.txt", "../instances/swv_instances/swv09.txt", "../instances/swv_instances/swv10.txt", "../instances/swv_instances/swv11.txt", "../instances/swv_instances/swv12.txt", "../instances/swv_instances/swv13.txt", "../instances/swv_instances/swv14.txt", "../instances/swv_instances/swv15.txt", "../instances/swv_instances/swv16.txt", "../instances/swv_instances/swv17.txt", "../instances/swv_instances/swv18.txt", "../instances/swv_instances/swv19.txt", "../instances/swv_instances/swv20.txt"};
     int time_limit = 300; // (seconds)
     int seed = 1234;
 
     for (auto &instance_path: instances) {
-        tabu_bench(instance_path, time_limit, 0, seed);
-        memetic_bench(instance_path, time_limit, 0, seed);
+        int lb = proven_optimum(instance_path);
+        tabu_bench(instance_path, time_limit, lb, seed, neighbourhood);
+        memetic_bench(instance_path, time_limit, lb, seed);
     }
 }
\ No newline at end of file
@@ -0,0 +1,21 @@
+#include <iostream>
+#include "src/server.h"
+
+// resident solver, see SolverServer: daemon [--socket <path>] [--threads <#threads>]
+// without a socket it serves the requests on stdin and answers on stdout
+int main(int argc, char *argv[]) {
+    string socket_path;
+    unsigned int threads = 0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (string(argv[i]) == "--socket") socket_path = argv[i + 1];
+        if (string(argv[i]) == "--threads") threads = std::stoi(argv[i + 1]);
+    }
+
+    SolverServer server(threads);
+    if (socket_path.empty()) {
+        server.serveStream();
+    } else if (!server.serveSocket(socket_path)) {
+        std::cout << "Could not open the socket " << socket_path << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,23 @@
+#include <iostream>
+#include <chrono>
+#include "src/jssp.h"
+#include "src/island.h"
+
+using namespace std::chrono;
+
+// local launcher for the island model: islands [instance] [#islands] [time limit] [interval] [#elite] [ring|full]
+int main(int argc, char *argv[]) {
+    string instance_path = argc > 1 ? argv[1] : "../instances/abz_instances/abz5.txt";
+    auto config = IslandConfig();
+    config.islandCount = argc > 2 ? std::stoi(argv[2]) : 4;
+    int time_limit = argc > 3 ? std::stoi(argv[3]) : 5; // (seconds)
+    config.migrationInterval = argc > 4 ? std::stoi(argv[4]) : 10;
+    config.eliteCount = argc > 5 ? std::stoi(argv[5]) : 2;
+    config.topology = (argc > 6 && string(argv[6]) == "full") ? fully_connected : ring;
+
+    auto t0 = high_resolution_clock::now();
+    BMResult result = IslandModel::launchLocal(instance_path, config, time_limit);
+
+    long long total_time = duration_cast<milliseconds>(high_resolution_clock::now() - t0).count();
+    std::cout << "Islands " << config.islandCount << ", Time " << total_time << ", Makespan " << result.makespan << std::endl;
+}
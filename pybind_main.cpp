@@ -18,6 +18,8 @@ PYBIND11_MODULE(metaheuristic, m) {
 
             JSSPInstance
             BMResult
+            Solution
+            FlatSolution
             TabuSearch
             MemeticAlgorithm
 
@@ -25,7 +27,7 @@ PYBIND11_MODULE(metaheuristic, m) {
     py::class_<JSSPInstance>(m, "JSSPInstance")
             .def(py::init<std::string &>())
             .def(py::init<std::string &, int>())
-            .def("calcMakespan", &JSSPInstance::calcMakespan)
+            .def("calcMakespan", py::overload_cast<std::vector<std::vector<int>> const &>(&JSSPInstance::calcMakespan, py::const_))
             .def("generateRandomSolution", &JSSPInstance::generateRandomSolution)
             .def("getSeed",&JSSPInstance::getSeed);
     py::class_<BMResult>(m, "BMResult")
@@ -37,6 +39,14 @@ PYBIND11_MODULE(metaheuristic, m) {
             .def(py::init<std::vector<std::vector<int>>, int>())
             .def_readwrite("solution", &Solution::solution)
             .def_readwrite("makespan", &Solution::makespan);
+    py::class_<FlatSolution>(m, "FlatSolution")
+            .def(py::init<Solution const &>())
+            .def(py::init<std::vector<std::vector<int>> const &, int>())
+            .def_readwrite("sequence", &FlatSolution::sequence)
+            .def_readwrite("stride", &FlatSolution::stride)
+            .def_readwrite("makespan", &FlatSolution::makespan)
+            .def("toNested", &FlatSolution::toNested)
+            .def("toSolution", &FlatSolution::toSolution);
     py::class_<TabuSearch>(m,"TabuSearch")
             .def(py::init<JSSPInstance &>())
             .def("optimize", &TabuSearch::optimize)
@@ -0,0 +1,83 @@
+#ifndef HYBRID_EVO_ALGORITHM_ARENA_H
+#define HYBRID_EVO_ALGORITHM_ARENA_H
+
+#include <memory_resource>
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+/**
+ * monotonic arena for short living scratch containers (std::pmr::vector) of the algorithms.
+ * allocation moves a pointer forward, deallocation is a no-op and reset() frees everything at once. Memory is kept
+ * between resets, so once the arena grew to the peak demand of one round it never allocates from the heap again.
+ */
+class ScratchArena : public std::pmr::memory_resource {
+public:
+    explicit ScratchArena(size_t initial_size = 1 << 16) {
+        blocks.emplace_back(Block{std::make_unique<char[]>(initial_size), initial_size});
+    };
+
+    /**
+     * free all allocations. if the last round needed more than one block, the blocks are merged into one block large
+     * enough for the whole round
+     */
+    void reset() {
+        if (blocks.size() > 1) {
+            size_t total_size = 0;
+            for (auto const &block: blocks) total_size += block.size;
+            blocks.clear();
+            blocks.emplace_back(Block{std::make_unique<char[]>(total_size), total_size});
+        }
+        offset = 0;
+    };
+
+    /**
+     * position of the arena, allocations after it can be freed early with rewind()
+     */
+    struct Marker {
+        size_t block;
+        size_t offset;
+    };
+
+    Marker mark() const { return Marker{blocks.size() - 1, offset}; };
+
+    /**
+     * free all allocations made after the marker. Only possible if the arena did not grow a new block since, otherwise
+     * the memory is freed with the next reset()
+     * @param marker
+     */
+    void rewind(Marker const &marker) {
+        if (marker.block == blocks.size() - 1) offset = marker.offset;
+    };
+
+private:
+    struct Block {
+        std::unique_ptr<char[]> memory;
+        size_t size;
+    };
+    std::vector<Block> blocks;
+    // first free byte in blocks.back()
+    size_t offset = 0;
+
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        auto &block = blocks.back();
+        size_t aligned = (offset + alignment - 1) & ~(alignment - 1);
+        if (aligned + bytes > block.size) {
+            size_t size = std::max(2 * block.size, bytes + alignment);
+            blocks.emplace_back(Block{std::make_unique<char[]>(size), size});
+            offset = 0;
+            return do_allocate(bytes, alignment);
+        }
+        offset = aligned + bytes;
+        return block.memory.get() + aligned;
+    };
+
+    void do_deallocate(void *, size_t, size_t) override {};
+
+    [[nodiscard]] bool do_is_equal(std::pmr::memory_resource const &other) const noexcept override {
+        return this == &other;
+    };
+};
+
+
+#endif //HYBRID_EVO_ALGORITHM_ARENA_H
@@ -0,0 +1,246 @@
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include "batch.h"
+#include "heuristics.h"
+
+BatchSolver::BatchSolver(unsigned int threads, double slice_seconds): threadCount(threads), sliceSeconds(slice_seconds) {
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+}
+
+size_t BatchSolver::add(JSSPInstance const &instance, double budget, int priority, BatchAlgorithm algorithm, int lower_bound) {
+    auto task = std::make_unique<Task>();
+    task->id = tasks.size();
+    task->jobs = instance.instance;
+    task->budget = budget;
+    task->priority = priority;
+    task->algorithm = algorithm;
+    task->lowerBound = lower_bound;
+    tasks.push_back(std::move(task));
+    return tasks.back()->id;
+}
+
+/**
+ * runs the worker threads until all tasks are reported
+ * @param on_result called for each complete task
+ * @return results by task number
+ */
+vector<BMResult> BatchSolver::solve(std::function<void(size_t task, BMResult const &result)> const &on_result) {
+    results = vector<BMResult>(tasks.size());
+    resultCallback = on_result ? &on_result : nullptr;
+    pending.clear();
+    for (auto &task: tasks) pending.push_back(task.get());
+    // stable: equal priorities start in the order they were added
+    std::stable_sort(pending.begin(), pending.end(), [](Task const *a, Task const *b) { return a->priority > b->priority; });
+    std::reverse(pending.begin(), pending.end());
+    queues.clear();
+    for (unsigned int i = 0; i < threadCount; i++) queues.push_back(std::make_unique<WorkerQueue>());
+    remainingTasks = tasks.size();
+    slices = 0;
+    steals = 0;
+    helperRuns = 0;
+
+    vector<std::thread> workers;
+    for (unsigned int i = 0; i < threadCount; i++) workers.emplace_back(&BatchSolver::work, this, static_cast<int>(i));
+    for (auto &worker: workers) worker.join();
+
+    batchStatistics = BatchStatistics{slices, steals, helperRuns};
+    tasks.clear();
+    resultCallback = nullptr;
+    return std::move(results);
+}
+
+void BatchSolver::work(int worker) {
+    while (remainingTasks > 0) {
+        Run *run = nextRun(worker);
+        if (run == nullptr) {
+            // all tasks are busy on other threads, wait for a parked run or the end
+            std::unique_lock<std::mutex> lock(idleMutex);
+            idleCondition.wait_for(lock, std::chrono::milliseconds(1));
+            continue;
+        }
+        runSlice(*run, worker);
+    }
+    idleCondition.notify_all();
+}
+
+/**
+ * a pending task of higher priority than the own runs, the newest own run, a stolen run or a helper run
+ * @param worker
+ * @return run, nullptr if there is nothing to do
+ */
+BatchSolver::Run *BatchSolver::nextRun(int worker) {
+    auto &queue = *queues[worker];
+    int own_priority = INT32_MIN;
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.runs.empty()) own_priority = queue.runs.back()->task->priority;
+    }
+    if (Run *run = startPending(own_priority)) return run;
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.runs.empty()) {
+            Run *run = queue.runs.back();
+            queue.runs.pop_back();
+            return run;
+        }
+    }
+    if (Run *run = steal(worker)) return run;
+    return startHelper();
+}
+
+BatchSolver::Run *BatchSolver::startPending(int min_priority) {
+    Task *task;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        if (pending.empty() || pending.back()->priority <= min_priority) return nullptr;
+        task = pending.back();
+        pending.pop_back();
+    }
+    return startRun(*task);
+}
+
+/**
+ * takes the oldest run of the other workers, starting with the next one
+ * @param worker
+ * @return run, nullptr if all queues are empty
+ */
+BatchSolver::Run *BatchSolver::steal(int worker) {
+    for (unsigned int i = 1; i < threadCount; i++) {
+        auto &queue = *queues[(worker + i) % threadCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.runs.empty()) {
+            Run *run = queue.runs.front();
+            queue.runs.pop_front();
+            ++steals;
+            return run;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * an additional run on the started unfinished task with the highest priority and the most remaining budget. A task
+ * gets at most one run per thread
+ * @return run, nullptr if no task can take one
+ */
+BatchSolver::Run *BatchSolver::startHelper() {
+    Task *best = nullptr;
+    double best_remaining = 0;
+    for (auto &task: tasks) {
+        std::lock_guard<std::mutex> lock(task->mutex);
+        if (task->runCount == 0 || task->done || task->runCount >= static_cast<int>(threadCount)) continue;
+        double remaining = task->budget - task->used;
+        if (best == nullptr || task->priority > best->priority ||
+            (task->priority == best->priority && remaining > best_remaining)) {
+            best = task.get();
+            best_remaining = remaining;
+        }
+    }
+    if (best == nullptr) return nullptr;
+    Run *run = startRun(*best);
+    if (run != nullptr) ++helperRuns;
+    return run;
+}
+
+/**
+ * the first run of a tabu search task starts from the shifting bottleneck solution, further ones from random mixtures
+ * of the dispatching rules. The first memetic run starts from Heuristics::population, further ones from random
+ * solutions. The setup (start solutions and engine) is charged to the budget of the task like a slice
+ * @param task
+ * @return the started run, nullptr if the task is already done
+ */
+BatchSolver::Run *BatchSolver::startRun(Task &task) {
+    int index;
+    {
+        std::lock_guard<std::mutex> lock(task.mutex);
+        if (task.done) return nullptr;
+        index = task.runCount++;
+        ++task.liveRuns;
+    }
+    auto setup_start = std::chrono::steady_clock::now();
+    auto run = std::make_unique<Run>();
+    run->task = &task;
+    run->instance = std::make_unique<JSSPInstance>(task.jobs, static_cast<int>(task.id * 7919 + index));
+    auto &instance = *run->instance;
+    if (task.algorithm == batch_memetic) {
+        run->memetic = std::make_unique<MemeticAlgorithm>(instance);
+        // the run is one of the threads of the pool, also for the random start solutions
+        run->memetic->setThreads(1);
+        run->memetic->start(index == 0 ? Heuristics::population(instance, 30) : vector<Solution>(), task.lowerBound);
+    } else {
+        run->tabuSearch = std::make_unique<TabuSearch>(instance);
+        Solution start;
+        if (index == 0) {
+            start = Heuristics::shiftingBottleneck(instance);
+        } else {
+            start.solution = Heuristics::randomRuleMixture(instance);
+            start.makespan = instance.calcMakespan(start.solution);
+        }
+        run->tabuSearch->start(start, task.lowerBound);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - setup_start;
+    std::lock_guard<std::mutex> lock(task.mutex);
+    // a budget used up by the setup retires the run at its first slice
+    task.used += elapsed.count();
+    if (task.used >= task.budget) task.done = true;
+    task.runs.push_back(std::move(run));
+    return task.runs.back().get();
+}
+
+/**
+ * one time slice, the used time is charged to the task
+ * @param run
+ * @param worker
+ */
+void BatchSolver::runSlice(Run &run, int worker) {
+    Task &task = *run.task;
+    bool done;
+    {
+        std::lock_guard<std::mutex> lock(task.mutex);
+        done = task.done;
+    }
+    if (done) {
+        // another run of the task used up the budget or reached the lower bound
+        retire(run);
+        return;
+    }
+    auto slice_start = std::chrono::steady_clock::now();
+    bool open = run.tabuSearch ? run.tabuSearch->step(0, sliceSeconds) : run.memetic->step(0, sliceSeconds);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - slice_start;
+    ++slices;
+    {
+        std::lock_guard<std::mutex> lock(task.mutex);
+        task.used += elapsed.count();
+        if (!open || task.used >= task.budget) task.done = true;
+        if (!task.done) {
+            std::lock_guard<std::mutex> queue_lock(queues[worker]->mutex);
+            queues[worker]->runs.push_back(&run);
+            return;
+        }
+    }
+    retire(run);
+}
+
+/**
+ * called without the lock of the task
+ * @param run
+ */
+void BatchSolver::retire(Run &run) {
+    Task &task = *run.task;
+    BMResult result = run.tabuSearch ? run.tabuSearch->finish() : run.memetic->finish();
+    {
+        std::lock_guard<std::mutex> lock(task.mutex);
+        if (result.makespan < task.result.makespan) task.result = std::move(result);
+        if (--task.liveRuns > 0) return;
+        // all runs are retired, free the engines
+        task.runs.clear();
+    }
+    {
+        std::lock_guard<std::mutex> lock(resultMutex);
+        results[task.id] = task.result;
+        if (resultCallback != nullptr) (*resultCallback)(task.id, task.result);
+    }
+    --remainingTasks;
+    idleCondition.notify_all();
+}
@@ -0,0 +1,145 @@
+#ifndef HYBRID_EVO_ALGORITHM_BATCH_H
+#define HYBRID_EVO_ALGORITHM_BATCH_H
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <condition_variable>
+#include "jssp.h"
+#include "ts.h"
+#include "mem.h"
+
+/**
+ * algorithm of a task of the batch solver
+ */
+enum BatchAlgorithm {batch_tabu_search, batch_memetic};
+
+/**
+ * counters of the last BatchSolver::solve
+ * slices: time slices of all runs, steals: runs taken from the queue of another worker, helperRuns: additional runs on
+ * an instance, started by idle workers
+ */
+struct BatchStatistics {
+    long slices = 0;
+    long steals = 0;
+    long helperRuns = 0;
+};
+
+/**
+ * solves many instances on a fixed number of threads. Each task (instance, budget, priority) is solved by one or more
+ * runs of its algorithm, which advance in time slices with the resumable API (start / step / finish). After a slice the
+ * worker keeps its run in its own queue, a higher priority task which did not start yet takes its place and the parked
+ * run can be stolen by an idle worker. A worker without own work starts the next task, steals the oldest run of
+ * another worker or starts an additional run (other seed and start solution) of the unfinished task with the highest
+ * priority and the most remaining budget, so threads freed by easy instances go to the hard ones.
+ * A task is complete when its budget (seconds of setup and search, summed over its runs) is used or a run reaches its
+ * lower bound; its result is the best result of its runs
+ */
+class BatchSolver {
+public:
+    /**
+     * @param threads number of worker threads, 0: all cores
+     * @param slice_seconds length of a time slice of a run
+     */
+    explicit BatchSolver(unsigned int threads = 0, double slice_seconds = 0.05);
+
+    /**
+     * add an instance to the next solve, the instance is copied
+     * @param instance
+     * @param budget seconds of the task, start solutions and search summed over all threads working on it
+     * @param priority higher priorities start first and take the place of lower ones
+     * @param algorithm
+     * @param lower_bound known optimum or lower bound for an early stop, see JSSPInstance::stopMakespan
+     * @return task number, index of the result of solve
+     */
+    size_t add(JSSPInstance const &instance, double budget, int priority = 0, BatchAlgorithm algorithm = batch_tabu_search,
+               int lower_bound = 0);
+
+    /**
+     * solves all added tasks and removes them
+     * @param on_result called with task number and result as soon as a task is complete, by one thread at a time
+     * @return results in the order of the task numbers
+     */
+    vector<BMResult> solve(std::function<void(size_t task, BMResult const &result)> const &on_result = {});
+
+    [[nodiscard]] BatchStatistics const &statistics() const { return batchStatistics; };
+
+private:
+    struct Task;
+
+    // one search on a task, with its own copy of the instance (the algorithms draw seeds from it)
+    struct Run {
+        Task *task;
+        std::unique_ptr<JSSPInstance> instance;
+        std::unique_ptr<TabuSearch> tabuSearch;
+        std::unique_ptr<MemeticAlgorithm> memetic;
+    };
+
+    struct Task {
+        size_t id;
+        vector<vector<Operation>> jobs;
+        double budget;
+        int priority;
+        BatchAlgorithm algorithm;
+        int lowerBound;
+
+        // guards the fields below
+        std::mutex mutex;
+        double used = 0;
+        bool done = false;
+        // runs which are not retired, the result is reported when the last one of a done task retires
+        int liveRuns = 0;
+        int runCount = 0;
+        BMResult result{{}, INT32_MAX, {}};
+        vector<std::unique_ptr<Run>> runs;
+    };
+
+    // run queue of a worker: the owner takes the newest run, thieves the oldest
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Run *> runs;
+    };
+
+    unsigned int threadCount;
+    double sliceSeconds;
+    BatchStatistics batchStatistics;
+
+    vector<std::unique_ptr<Task>> tasks;
+    // tasks which did not start, sorted by priority (highest last)
+    vector<Task *> pending;
+    std::mutex pendingMutex;
+    vector<std::unique_ptr<WorkerQueue>> queues;
+
+    std::atomic<size_t> remainingTasks{0};
+    std::atomic<long> slices{0}, steals{0}, helperRuns{0};
+    std::mutex idleMutex;
+    std::condition_variable idleCondition;
+
+    vector<BMResult> results;
+    std::function<void(size_t, BMResult const &)> const *resultCallback = nullptr;
+    std::mutex resultMutex;
+
+    void work(int worker);
+
+    // the next run of a worker, nullptr if there is no work right now
+    Run *nextRun(int worker);
+
+    // a started pending task with a higher priority than min_priority, nullptr if there is none
+    Run *startPending(int min_priority);
+    Run *steal(int worker);
+    Run *startHelper();
+
+    // creates and starts a run of a task, nullptr if the task is already done
+    Run *startRun(Task &task);
+
+    // one time slice of a run, afterwards it goes back to the queue of the worker or retires
+    void runSlice(Run &run, int worker);
+
+    // merges the result of a run into its task and reports the task when it was the last run
+    void retire(Run &run);
+};
+
+
+#endif //HYBRID_EVO_ALGORITHM_BATCH_H
@@ -0,0 +1,380 @@
+#include "bnb.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+BranchAndBound::BranchAndBound(JSSPInstance const &instance) {
+    init(BranchAndBoundProblem{instance.instance, instance.machineCount, {}, {}});
+}
+
+BranchAndBound::BranchAndBound(BranchAndBoundProblem const &problem) {
+    init(problem);
+}
+
+/**
+ * numbers the operations job by job and links the job chains
+ * @param problem
+ */
+void BranchAndBound::init(BranchAndBoundProblem const &problem) {
+    machineCount = problem.machineCount;
+    machineOps = vector<vector<int>>(machineCount);
+    for (int j = 0; j < static_cast<int>(problem.jobs.size()); j++) {
+        auto const &operations = problem.jobs[j];
+        for (int index = 0; index < static_cast<int>(operations.size()); index++) {
+            int op = opCount++;
+            duration.emplace_back(operations[index].duration);
+            machine.emplace_back(operations[index].machine);
+            job.emplace_back(j);
+            jobPredecessor.emplace_back(index > 0 ? op - 1 : -1);
+            jobSuccessor.emplace_back(index < static_cast<int>(operations.size()) - 1 ? op + 1 : -1);
+            release.emplace_back(problem.release.empty() ? 0 : problem.release[j][index]);
+            delivery.emplace_back(problem.delivery.empty() ? 0 : problem.delivery[j][index]);
+            machinePosition.emplace_back(static_cast<int>(machineOps[operations[index].machine].size()));
+            machineOps[operations[index].machine].emplace_back(op);
+        }
+    }
+    order = vector<vector<int8_t>>(machineCount);
+    for (int m = 0; m < machineCount; m++) order[m].assign(machineOps[m].size() * machineOps[m].size(), 0);
+    selectedPredecessors = vector<vector<int>>(opCount);
+    selectedSuccessors = vector<vector<int>>(opCount);
+    head = vector<int>(opCount);
+    tail = vector<int>(opCount);
+    topologicalOrder = vector<int>(opCount);
+    predecessorCount = vector<int>(opCount);
+    start = vector<int>(opCount);
+    sequences = vector<vector<int>>(machineCount);
+}
+
+BranchAndBoundResult BranchAndBound::solve(long node_limit, double time_limit) {
+    upperBound = std::numeric_limits<int>::max();
+    bestSequences = vector<vector<int>>(machineCount);
+    return run(node_limit, time_limit);
+}
+
+/**
+ * branch and bound with a start solution as first upper bound. The objective of the start solution is recalculated
+ * @param start feasible solution of the problem (machine sequences of job numbers)
+ * @param node_limit
+ * @param time_limit
+ * @return best solution found, lower bound and optimality certificate
+ */
+BranchAndBoundResult BranchAndBound::solve(Solution const &start_solution, long node_limit, double time_limit) {
+    // the start solution as selection, its list schedule is the solution itself
+    for (int m = 0; m < machineCount; m++) {
+        for (size_t pos = 1; pos < start_solution.solution[m].size(); pos++) {
+            int from = -1, to = -1;
+            for (int op: machineOps[m]) {
+                if (job[op] == start_solution.solution[m][pos - 1]) from = op;
+                if (job[op] == start_solution.solution[m][pos]) to = op;
+            }
+            fix(from, to);
+        }
+    }
+    upperBound = std::numeric_limits<int>::max();
+    bestSequences = vector<vector<int>>(machineCount);
+    schedule();
+    undo(0);
+    return run(node_limit, time_limit);
+}
+
+/**
+ * root of the search
+ * @param node_limit
+ * @param time_limit
+ * @return result
+ */
+BranchAndBoundResult BranchAndBound::run(long node_limit, double time_limit) {
+    nodeLimit = node_limit;
+    timeLimit = time_limit;
+    nodeCount = 0;
+    aborted = false;
+    startTime = std::chrono::steady_clock::now();
+
+    calcHeadsAndTails();
+    int root_bound = lowerBound();
+    search();
+    // arcs fixed by the propagation of the root depend on this upper bound, the next solve starts without them
+    undo(0);
+
+    bool optimal = !aborted;
+    int lower_bound = optimal ? upperBound : std::min(root_bound, upperBound);
+    return BranchAndBoundResult{Solution{bestSequences, upperBound}, lower_bound, optimal, nodeCount};
+}
+
+bool BranchAndBound::fix(int from, int to) {
+    int m = machine[from];
+    auto size = machineOps[m].size();
+    auto &arc = order[m][machinePosition[from] * size + machinePosition[to]];
+    if (arc != 0) return arc == 1;
+    arc = 1;
+    order[m][machinePosition[to] * size + machinePosition[from]] = -1;
+    selectedSuccessors[from].emplace_back(to);
+    selectedPredecessors[to].emplace_back(from);
+    trail.emplace_back(from, to);
+    return true;
+}
+
+void BranchAndBound::undo(size_t mark) {
+    while (trail.size() > mark) {
+        auto [from, to] = trail.back();
+        trail.pop_back();
+        int m = machine[from];
+        auto size = machineOps[m].size();
+        order[m][machinePosition[from] * size + machinePosition[to]] = 0;
+        order[m][machinePosition[to] * size + machinePosition[from]] = 0;
+        selectedSuccessors[from].pop_back();
+        selectedPredecessors[to].pop_back();
+    }
+}
+
+/**
+ * heads (longest path from the source, at least the release time) and tails (longest path from the end of the
+ * operation to the sink, at least the delivery time) on the job chains and the selected arcs, in topological order
+ * @return false if the selection contains a cycle
+ */
+bool BranchAndBound::calcHeadsAndTails() {
+    int ordered = 0;
+    for (int op = 0; op < opCount; op++) {
+        predecessorCount[op] = (jobPredecessor[op] >= 0) + static_cast<int>(selectedPredecessors[op].size());
+        if (predecessorCount[op] == 0) topologicalOrder[ordered++] = op;
+    }
+    for (int pos = 0; pos < ordered; pos++) {
+        int op = topologicalOrder[pos];
+        head[op] = release[op];
+        if (jobPredecessor[op] >= 0) head[op] = std::max(head[op], head[jobPredecessor[op]] + duration[jobPredecessor[op]]);
+        for (int predecessor: selectedPredecessors[op]) head[op] = std::max(head[op], head[predecessor] + duration[predecessor]);
+        if (jobSuccessor[op] >= 0 && --predecessorCount[jobSuccessor[op]] == 0) topologicalOrder[ordered++] = jobSuccessor[op];
+        for (int successor: selectedSuccessors[op]) {
+            if (--predecessorCount[successor] == 0) topologicalOrder[ordered++] = successor;
+        }
+    }
+    if (ordered != opCount) return false;
+    for (int pos = opCount - 1; pos >= 0; pos--) {
+        int op = topologicalOrder[pos];
+        tail[op] = delivery[op];
+        if (jobSuccessor[op] >= 0) tail[op] = std::max(tail[op], tail[jobSuccessor[op]] + duration[jobSuccessor[op]]);
+        for (int successor: selectedSuccessors[op]) tail[op] = std::max(tail[op], tail[successor] + duration[successor]);
+    }
+    return true;
+}
+
+/**
+ * lower bound of the node: longest path of the selection and the preemptive one machine bound of each machine with
+ * the heads and tails of the selection
+ * @return lower bound
+ */
+int BranchAndBound::lowerBound() const {
+    int bound = 0;
+    for (int op = 0; op < opCount; op++) bound = std::max(bound, head[op] + duration[op] + tail[op]);
+    auto operations = vector<std::tuple<int, int, int>>();
+    for (int m = 0; m < machineCount; m++) {
+        operations.clear();
+        for (int op: machineOps[m]) operations.emplace_back(head[op], duration[op], tail[op]);
+        bound = std::max(bound, preemptiveOneMachineBound(operations));
+    }
+    return bound;
+}
+
+/**
+ * computes heads and tails and fixes all disjunctions, which only fit in one direction with a value below the upper
+ * bound (a before b needs head_a + p_a + p_b + tail_b < upper bound), until no arc is added
+ * @param bound lower bound of the node
+ * @return false if the node contains no solution better than the upper bound
+ */
+bool BranchAndBound::propagate(int &bound) {
+    bool changed = true;
+    while (changed) {
+        if (!calcHeadsAndTails()) return false;
+        bound = lowerBound();
+        if (bound >= upperBound) return false;
+        changed = false;
+        for (int m = 0; m < machineCount; m++) {
+            auto const &ops = machineOps[m];
+            auto size = ops.size();
+            for (size_t a = 0; a < size; a++) {
+                for (size_t b = a + 1; b < size; b++) {
+                    if (order[m][a * size + b] != 0) continue;
+                    int u = ops[a], v = ops[b];
+                    bool u_first = head[u] + duration[u] + duration[v] + tail[v] < upperBound;
+                    bool v_first = head[v] + duration[v] + duration[u] + tail[u] < upperBound;
+                    if (!u_first && !v_first) return false;
+                    if (u_first && v_first) continue;
+                    if (u_first) fix(u, v);
+                    else fix(v, u);
+                    changed = true;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * list schedule which respects the selection: an operation can be scheduled when its job and selected predecessors
+ * are. Like Giffler-Thompson, the operations of the conflict set of the machine with the earliest completion compete,
+ * the longest tail wins
+ * @return objective max(C + delivery) of the schedule
+ */
+int BranchAndBound::schedule() {
+    auto &waiting = predecessorCount;
+    auto eligible = vector<int>();
+    for (int op = 0; op < opCount; op++) {
+        waiting[op] = (jobPredecessor[op] >= 0) + static_cast<int>(selectedPredecessors[op].size());
+        if (waiting[op] == 0) eligible.emplace_back(op);
+    }
+    auto machine_ready = vector<int>(machineCount, 0);
+    for (auto &sequence: sequences) sequence.clear();
+    auto earliest_start = [&](int op) {
+        int time = std::max(release[op], machine_ready[machine[op]]);
+        if (jobPredecessor[op] >= 0) time = std::max(time, start[jobPredecessor[op]] + duration[jobPredecessor[op]]);
+        return time;
+    };
+
+    int value = 0;
+    while (!eligible.empty()) {
+        int min_completion = std::numeric_limits<int>::max();
+        int m = 0;
+        for (int op: eligible) {
+            if (earliest_start(op) + duration[op] < min_completion) {
+                min_completion = earliest_start(op) + duration[op];
+                m = machine[op];
+            }
+        }
+        int selected = -1;
+        for (int k = 0; k < static_cast<int>(eligible.size()); k++) {
+            int op = eligible[k];
+            if (machine[op] != m || earliest_start(op) >= min_completion) continue;
+            if (selected < 0 || tail[op] > tail[eligible[selected]]) selected = k;
+        }
+        int op = eligible[selected];
+        eligible[selected] = eligible.back();
+        eligible.pop_back();
+
+        start[op] = earliest_start(op);
+        machine_ready[m] = start[op] + duration[op];
+        sequences[m].emplace_back(op);
+        value = std::max(value, start[op] + duration[op] + delivery[op]);
+        if (jobSuccessor[op] >= 0 && --waiting[jobSuccessor[op]] == 0) eligible.emplace_back(jobSuccessor[op]);
+        for (int successor: selectedSuccessors[op]) {
+            if (--waiting[successor] == 0) eligible.emplace_back(successor);
+        }
+    }
+    if (value < upperBound) {
+        upperBound = value;
+        for (int m = 0; m < machineCount; m++) {
+            bestSequences[m].clear();
+            for (int op: sequences[m]) bestSequences[m].emplace_back(job[op]);
+        }
+    }
+    return value;
+}
+
+/**
+ * a critical path of the list schedule, traced back from an operation which defines the objective, preferring machine
+ * predecessors. Blocks are the maximal runs of the path on one machine
+ * @return blocks with at least two operations, in path order
+ */
+vector<vector<int>> BranchAndBound::criticalBlocks() {
+    int value = 0, last = 0;
+    for (int op = 0; op < opCount; op++) {
+        if (start[op] + duration[op] + delivery[op] > value) {
+            value = start[op] + duration[op] + delivery[op];
+            last = op;
+        }
+    }
+    // machine predecessor of each operation in the list schedule
+    auto machine_predecessor = vector<int>(opCount, -1);
+    for (auto const &sequence: sequences) {
+        for (size_t pos = 1; pos < sequence.size(); pos++) machine_predecessor[sequence[pos]] = sequence[pos - 1];
+    }
+    auto blocks = vector<vector<int>>{{last}};
+    int op = last;
+    while (true) {
+        int mp = machine_predecessor[op];
+        int jp = jobPredecessor[op];
+        if (mp >= 0 && start[mp] + duration[mp] == start[op]) {
+            blocks.back().emplace_back(mp);
+            op = mp;
+        } else if (jp >= 0 && start[jp] + duration[jp] == start[op]) {
+            blocks.emplace_back(vector<int>{jp});
+            op = jp;
+        } else {
+            break;
+        }
+    }
+    blocks.erase(std::remove_if(blocks.begin(), blocks.end(), [](vector<int> const &block) { return block.size() < 2; }),
+                 blocks.end());
+    std::reverse(blocks.begin(), blocks.end());
+    for (auto &block: blocks) std::reverse(block.begin(), block.end());
+    return blocks;
+}
+
+/**
+ * one node: bound, list schedule, branching on the critical blocks. Children of block j keep the first and last
+ * operation of all earlier blocks (a better solution changes one of them in the first block it changes), then either
+ * move an operation before the first of block j, or keep the first and move an inner operation after the last. The
+ * children are visited in the order of their lower bounds
+ */
+void BranchAndBound::search() {
+    if (limitReached()) {
+        aborted = true;
+        return;
+    }
+    ++nodeCount;
+    int bound = 0;
+    if (!propagate(bound)) return;
+    schedule();
+    if (bound >= upperBound) return;
+
+    auto blocks = criticalBlocks();
+    auto children = vector<vector<std::pair<int, int>>>();
+    auto prefix = vector<std::pair<int, int>>();
+    for (auto const &block: blocks) {
+        int first = block.front(), last = block.back();
+        for (int op: block) {
+            if (op == first) continue;
+            auto arcs = prefix;
+            for (int other: block) if (other != op) arcs.emplace_back(op, other);
+            children.emplace_back(std::move(arcs));
+        }
+        for (int op: block) {
+            if (op == first || op == last) continue;
+            auto arcs = prefix;
+            for (int other: block) if (other != first) arcs.emplace_back(first, other);
+            for (int other: block) if (other != op) arcs.emplace_back(other, op);
+            children.emplace_back(std::move(arcs));
+        }
+        for (int op: block) {
+            if (op != first) prefix.emplace_back(first, op);
+            if (op != last) prefix.emplace_back(op, last);
+        }
+    }
+
+    size_t mark = trail.size();
+    auto child_bounds = vector<std::pair<int, int>>();
+    for (int child = 0; child < static_cast<int>(children.size()); child++) {
+        bool feasible = true;
+        for (auto [from, to]: children[child]) feasible = feasible && fix(from, to);
+        if (feasible && calcHeadsAndTails()) {
+            int child_bound = lowerBound();
+            if (child_bound < upperBound) child_bounds.emplace_back(child_bound, child);
+        }
+        undo(mark);
+    }
+    std::sort(child_bounds.begin(), child_bounds.end());
+    for (auto [child_bound, child]: child_bounds) {
+        if (child_bound >= upperBound || aborted) break;
+        for (auto [from, to]: children[child]) fix(from, to);
+        search();
+        undo(mark);
+    }
+}
+
+bool BranchAndBound::limitReached() {
+    if (nodeLimit > 0 && nodeCount >= nodeLimit) return true;
+    if (timeLimit > 0 && nodeCount % 64 == 0) {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+        return elapsed.count() > timeLimit;
+    }
+    return false;
+}
@@ -0,0 +1,118 @@
+#ifndef HYBRID_EVO_ALGORITHM_BNB_H
+#define HYBRID_EVO_ALGORITHM_BNB_H
+
+#include <chrono>
+#include "jssp.h"
+
+/**
+ * problem of the branch and bound: jobs (chains of operations) with a release time (earliest start) and a delivery time
+ * (time which passes after the end) of each operation. The objective is max(C + delivery) over all operations.
+ * A full instance has no release and delivery times. A subproblem of another engine, e.g. a window of a larger
+ * schedule, carries the fixed operations around it in them. Jobs may have operations on only some of the machines
+ * release[job][index] / delivery[job][index]: of the index-th operation of the job, empty vectors mean all 0
+ */
+struct BranchAndBoundProblem {
+    vector<vector<Operation>> jobs;
+    int machineCount = 0;
+    vector<vector<int>> release;
+    vector<vector<int>> delivery;
+};
+
+/**
+ * result of BranchAndBound::solve
+ * solution: machine sequences (job numbers) of the best solution and its objective value (the makespan)
+ * lowerBound: proven lower bound of the objective, equal to the makespan if the solution is optimal
+ * optimal: certificate of optimality, the search tree was explored completely (no node or time limit was hit)
+ */
+struct BranchAndBoundResult {
+    Solution solution;
+    int lowerBound;
+    bool optimal;
+    long nodes;
+};
+
+/**
+ * exact branch and bound on the disjunctive graph (Brucker, Jurisch and Sievers): each node is a selection of fixed
+ * machine arcs. A list schedule which respects the selection gives an upper bound, its critical path is split into
+ * blocks, and the children move an operation of a block before its first or after its last operation - a better
+ * solution has to do this for at least one block. Nodes are bounded by heads and tails of the selection and Jackson's
+ * preemptive schedule of each machine, disjunctions which only fit in one direction below the upper bound are fixed
+ * right away (immediate selection). Meant for small instances (up to ~10x10) and subproblems of other engines
+ */
+class BranchAndBound {
+public:
+    explicit BranchAndBound(JSSPInstance const &instance);
+    explicit BranchAndBound(BranchAndBoundProblem const &problem);
+
+    /**
+     * search for an optimal solution
+     * @param node_limit maximum number of nodes, 0: no limit
+     * @param time_limit maximum runtime in seconds, 0: no limit
+     * @return best solution found, lower bound and optimality certificate
+     */
+    BranchAndBoundResult solve(long node_limit = 0, double time_limit = 0);
+
+    // same, starting with a known solution as upper bound, e.g. a tabu search result. Has to be feasible
+    BranchAndBoundResult solve(Solution const &start, long node_limit = 0, double time_limit = 0);
+
+private:
+    // operations: ids job by job, in the order of the jobs
+    int opCount = 0;
+    int machineCount = 0;
+    vector<int> duration, machine, job, jobPredecessor, jobSuccessor, release, delivery;
+    // operation ids of each machine, machinePosition[op]: index of op in its machineOps
+    vector<vector<int>> machineOps;
+    vector<int> machinePosition;
+
+    // selection: order[m][a * size + b] = 1 if the a-th operation of machine m is fixed before the b-th, -1 after
+    vector<vector<int8_t>> order;
+    vector<vector<int>> selectedPredecessors, selectedSuccessors;
+    // fixed arcs in the order of fixing, undone on backtracking
+    vector<std::pair<int, int>> trail;
+
+    // heads (earliest start) and tails (time after the end) of the current selection
+    vector<int> head, tail;
+    vector<int> topologicalOrder, predecessorCount;
+
+    // list schedule of the current node
+    vector<int> start;
+    vector<vector<int>> sequences;
+
+    vector<vector<int>> bestSequences;
+    int upperBound = 0;
+    long nodeCount = 0, nodeLimit = 0;
+    double timeLimit = 0;
+    bool aborted = false;
+    std::chrono::steady_clock::time_point startTime;
+
+    void init(BranchAndBoundProblem const &problem);
+
+    // fix the arc from -> to, false if the opposite arc is fixed
+    bool fix(int from, int to);
+
+    void undo(size_t mark);
+
+    // heads and tails of the selection, false if it contains a cycle
+    bool calcHeadsAndTails();
+
+    // maximum of the longest path and the preemptive one machine bounds
+    int lowerBound() const;
+
+    // heads and tails, immediate selection until nothing changes. false if the node can be pruned
+    bool propagate(int &bound);
+
+    // list schedule consistent with the selection, writes start and sequences, returns the objective
+    int schedule();
+
+    // critical path blocks of the list schedule with at least two operations
+    vector<vector<int>> criticalBlocks();
+
+    void search();
+
+    bool limitReached();
+
+    BranchAndBoundResult run(long node_limit, double time_limit);
+};
+
+
+#endif //HYBRID_EVO_ALGORITHM_BNB_H
@@ -0,0 +1,69 @@
+#ifndef HYBRID_EVO_ALGORITHM_DISJUNCTIVE_GRAPH_H
+#define HYBRID_EVO_ALGORITHM_DISJUNCTIVE_GRAPH_H
+
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * internal struct for managing the operations in the disjunctive graph
+ * predecessors and successors are operation ids (index in the graph), Layout::nil if there is none
+ */
+template<typename IndexT, typename TimeT>
+struct BasicNode {
+    IndexT jobPredecessor;
+    IndexT machPredecessor;
+    IndexT jobSuccessor;
+    IndexT machSuccessor;
+    IndexT machine;
+    IndexT job;
+    TimeT start;
+    TimeT duration;
+    TimeT lenToN;
+};
+
+/**
+ * heads and tails of all operations of a disjunctive graph: start is the longest path from the source to the operation,
+ * lenToN the longest path from the end of the operation to the sink. The nodes are visited in topological order (Kahn),
+ * once in each direction. Machine arcs may be missing, e.g. for the unsequenced machines of the shifting bottleneck
+ * @param graph operations, linked by their ids
+ * @param op_count number of operations
+ * @param nil id of a missing link
+ * @param topological_order buffer for op_count ids
+ * @param predecessor_count buffer for op_count counters
+ * @param release earliest start of each operation, nullptr if all operations can start at 0
+ * @return makespan, -1 if the graph contains a cycle
+ */
+template<typename IndexT, typename TimeT>
+inline int calcHeadsAndTails(BasicNode<IndexT, TimeT> *graph, int op_count, IndexT nil, IndexT *topological_order,
+                             uint8_t *predecessor_count, TimeT const *release = nullptr) {
+    auto end_time = [graph, nil](IndexT op) { return op == nil ? 0 : graph[op].start + graph[op].duration; };
+    auto tail_length = [graph, nil](IndexT op) { return op == nil ? 0 : graph[op].lenToN + graph[op].duration; };
+
+    int ordered = 0;
+    for (int op = 0; op < op_count; op++) {
+        auto const &node = graph[op];
+        predecessor_count[op] = (node.jobPredecessor != nil) + (node.machPredecessor != nil);
+        if (predecessor_count[op] == 0) topological_order[ordered++] = static_cast<IndexT>(op);
+    }
+    for (int pos = 0; pos < ordered; pos++) {
+        auto &node = graph[topological_order[pos]];
+        node.start = static_cast<TimeT>(std::max(end_time(node.jobPredecessor), end_time(node.machPredecessor)));
+        if (release != nullptr) node.start = std::max(node.start, release[topological_order[pos]]);
+        for (IndexT successor: {node.machSuccessor, node.jobSuccessor}) {
+            if (successor != nil && --predecessor_count[successor] == 0) topological_order[ordered++] = successor;
+        }
+    }
+    if (ordered != op_count) return -1;
+
+    int makespan = 0;
+    for (int pos = op_count - 1; pos >= 0; pos--) {
+        auto &node = graph[topological_order[pos]];
+        node.lenToN = static_cast<TimeT>(std::max(tail_length(node.jobSuccessor), tail_length(node.machSuccessor)));
+        // with release times a path can start at any operation
+        makespan = std::max(makespan, (release != nullptr ? node.start : 0) + node.lenToN + node.duration);
+    }
+    return makespan;
+}
+
+
+#endif //HYBRID_EVO_ALGORITHM_DISJUNCTIVE_GRAPH_H
@@ -0,0 +1,113 @@
+#ifndef HYBRID_EVO_ALGORITHM_ELITE_ARCHIVE_H
+#define HYBRID_EVO_ALGORITHM_ELITE_ARCHIVE_H
+
+#include <algorithm>
+#include "jssp.h"
+
+/**
+ * number of machine sequence positions which hold different jobs in the two solutions. A single swap has distance 2
+ * @param solution_1
+ * @param solution_2
+ * @return distance
+ */
+template<typename IndexT, typename TimeT>
+inline int sequenceDistance(BasicFlatSolution<IndexT, TimeT> const &solution_1, BasicFlatSolution<IndexT, TimeT> const &solution_2) {
+    int distance = 0;
+    for (size_t i = 0; i < solution_1.sequence.size(); i++) {
+        distance += solution_1.sequence[i] != solution_2.sequence[i];
+    }
+    return distance;
+}
+
+/**
+ * archive of the best solutions found in a run, which are mutually distant: no two elites are closer than minDistance,
+ * see sequenceDistance. A single swap has distance 2, so minDistance 3 (the default) keeps solutions one swap apart
+ * out. Source of guiding solutions for path relinking and of restart solutions.
+ * elites are copied into slots which keep their storage, also over clear, so inserts do not allocate after warm-up
+ */
+template<typename IndexT, typename TimeT>
+class BasicEliteArchive {
+public:
+    using FlatSolutionT = BasicFlatSolution<IndexT, TimeT>;
+
+    explicit BasicEliteArchive(int capacity = 10, int min_distance = 3): capacity(capacity), minDistance(min_distance) {};
+
+    /**
+     * offer a solution to the archive. A solution closer than minDistance to elites replaces the closest of these
+     * elites, and the others are dropped, if it is better than all of them. Otherwise it is added, while the archive is
+     * not full, or replaces the worst elite, if it is better
+     * @param solution
+     * @return if the solution was taken into the archive
+     */
+    bool insert(FlatSolutionT const &solution) {
+        if (capacity == 0) return false;
+        int closest = -1;
+        int closest_distance = minDistance;
+        for (int i = 0; i < count; i++) {
+            int distance = sequenceDistance(solution, elites[i]);
+            if (distance >= minDistance) continue;
+            if (solution.makespan >= elites[i].makespan) return false;
+            if (distance < closest_distance) {
+                closest = i;
+                closest_distance = distance;
+            }
+        }
+        if (closest >= 0) {
+            elites[closest] = solution;
+            // the other close elites, swapped behind the elites so their slots keep the storage
+            for (int i = 0; i < count;) {
+                if (i != closest && sequenceDistance(solution, elites[i]) < minDistance) {
+                    --count;
+                    std::swap(elites[i], elites[count]);
+                    if (closest == count) closest = i;
+                } else {
+                    ++i;
+                }
+            }
+            return true;
+        }
+        if (count < capacity) {
+            if (count < static_cast<int>(elites.size())) elites[count] = solution;
+            else elites.emplace_back(solution);
+            ++count;
+            return true;
+        }
+        auto worst = std::max_element(elites.begin(), elites.begin() + count, [](FlatSolutionT const &a, FlatSolutionT const &b) {
+            return a.makespan < b.makespan; });
+        if (solution.makespan >= worst->makespan) return false;
+        *worst = solution;
+        return true;
+    }
+
+    void setParams(int _capacity, int _minDistance) {
+        capacity = _capacity;
+        minDistance = _minDistance;
+        count = std::min(count, capacity);
+    }
+
+    void clear() { count = 0; };
+
+    [[nodiscard]] bool empty() const { return count == 0; };
+
+    [[nodiscard]] int size() const { return count; };
+
+    [[nodiscard]] FlatSolutionT const &operator[](int i) const { return elites[i]; };
+
+    // elites as nested solutions, best first
+    [[nodiscard]] vector<Solution> toSolutions() const {
+        auto result = vector<Solution>();
+        for (int i = 0; i < count; i++) result.emplace_back(elites[i].toSolution());
+        std::sort(result.begin(), result.end(), [](Solution const &a, Solution const &b) { return a.makespan < b.makespan; });
+        return result;
+    }
+
+private:
+    int capacity;
+    int minDistance;
+    // slots, the first count are the elites
+    vector<FlatSolutionT> elites;
+    int count = 0;
+};
+
+
+#endif //HYBRID_EVO_ALGORITHM_ELITE_ARCHIVE_H
@@ -1,56 +1,89 @@
 #include "heuristics.h"
 #include <iostream>
+#include <queue>
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <limits>
+
+RandomScheduler::RandomScheduler(JSSPInstance const &instance): instance(instance), jobCount(instance.jobCount),
+        machineCount(instance.machineCount), sequence(jobCount * machineCount), start(jobCount * machineCount),
+        end(jobCount * machineCount), scheduledCount(machineCount), longestGap(machineCount), openJobs(jobCount),
+        nextOperation(jobCount), jobReady(jobCount) {}
+
 /**
- * inserts the operation as early as possible into the machine -> active solution
- * @param operation
+ * inserts the operation as early as possible into the machine: into the first idle gap which fits it after min_time,
+ * behind the last operation otherwise -> active solution. The gaps are scanned linearly, only if the operation fits
+ * into longestGap of the machine
+ * @param machine
+ * @param job
+ * @param duration
  * @param min_time -> job dependency
  * @return the starting time
  */
-unsigned int Machine::insert(const std::shared_ptr<MNode>& operation, unsigned int min_time) {
-    if (firstOp == nullptr) {
-        firstOp = operation;
-        operation->start = min_time;
-        return operation->start;
-    }
-
-    auto current_op = firstOp;
-    int time_gap_start = 0;
-    while (current_op->next) {
-        if (current_op->start - time_gap_start >= operation->duration && current_op->start - operation->duration >= min_time) {
-            if (current_op->previous) {
-                current_op->previous->next = operation;
-                operation->previous = current_op->previous;
-                operation->start = std::max(operation->previous->end(), min_time);
-            } else {
-                firstOp = operation;
-                operation->start = min_time;
+long long RandomScheduler::insert(int machine, int job, int duration, long long min_time) {
+    int base = machine * jobCount;
+    int count = scheduledCount[machine];
+    int position = count;
+    long long start_time = count == 0 ? min_time : std::max(end[base + count - 1], min_time);
+    if (longestGap[machine] >= duration) {
+        for (int k = 0; k < count; k++) {
+            long long gap_start = std::max(k == 0 ? 0 : end[base + k - 1], min_time);
+            if (gap_start + duration <= start[base + k]) {
+                position = k;
+                start_time = gap_start;
+                break;
             }
-            operation->next = current_op;
-            current_op->previous = operation;
-            return operation->start;
         }
-        time_gap_start = current_op->end();
-        current_op = current_op->next;
     }
-    current_op->next = operation;
-    operation->previous = current_op;
-    operation->start = std::max(current_op->end(), min_time);
-    return operation->start;
+    for (int k = count; k > position; k--) {
+        sequence[base + k] = sequence[base + k - 1];
+        start[base + k] = start[base + k - 1];
+        end[base + k] = end[base + k - 1];
+    }
+    sequence[base + position] = job;
+    start[base + position] = start_time;
+    end[base + position] = start_time + duration;
+    ++scheduledCount[machine];
+
+    if (position == count) {
+        long long gap = start_time - (count == 0 ? 0 : end[base + count - 1]);
+        longestGap[machine] = std::max(longestGap[machine], gap);
+    } else {
+        // the used gap was split, recalculate
+        longestGap[machine] = start[base];
+        for (int k = 1; k <= count; k++) longestGap[machine] = std::max(longestGap[machine], start[base + k] - end[base + k - 1]);
+    }
+    return start_time;
 }
 
 /**
- * get the operations job sequence
- * @return job sequence
+ * creates a random active solution, a random open job inserts its next operation each step
+ * @param rng
+ * @return a solution (machine sequence)
  */
-vector<int> Machine::getSequence() {
-    auto sequence = vector<int>();
-    auto current_op = firstOp;
-    while (current_op->next) {
-        sequence.emplace_back(current_op->job);
-        current_op = current_op->next;
-    }
-    sequence.emplace_back(current_op->job);
-    return sequence;
+vector<vector<int>> RandomScheduler::schedule(std::mt19937 &rng) {
+    std::fill(scheduledCount.begin(), scheduledCount.end(), 0);
+    std::fill(longestGap.begin(), longestGap.end(), 0);
+    std::fill(nextOperation.begin(), nextOperation.end(), 0);
+    std::fill(jobReady.begin(), jobReady.end(), 0);
+    std::iota(openJobs.begin(), openJobs.end(), 0);
+    openCount = jobCount;
+
+    while (openCount > 0) {
+        std::uniform_int_distribution<int> dist(0, openCount - 1);
+        int open_index = dist(rng);
+        int job = openJobs[open_index];
+        auto const &operation = instance.instance[job][nextOperation[job]];
+        jobReady[job] = insert(operation.machine, job, operation.duration, jobReady[job]) + operation.duration;
+        if (++nextOperation[job] == machineCount) openJobs[open_index] = openJobs[--openCount];
+    }
+
+    auto solution = vector<vector<int>>(machineCount);
+    for (int machine = 0; machine < machineCount; machine++) {
+        solution[machine].assign(sequence.begin() + machine * jobCount, sequence.begin() + (machine + 1) * jobCount);
+    }
+    return solution;
 }
 
 /**
@@ -58,32 +91,414 @@ vector<int> Machine::getSequence() {
  * @return a solution (machine sequence)
  */
 vector<vector<int>> Heuristics::random(JSSPInstance &instance) {
-    auto machines = vector<Machine>(instance.machineCount);
     auto rng = std::mt19937(instance.getSeed());
-    std::uniform_int_distribution<std::mt19937::result_type> dist(0, instance.jobCount - 1);
+    return RandomScheduler(instance).schedule(rng);
+}
 
-    auto job_index = vector<int>();
-    auto job_min_time = vector<long long>();
-    for (int i = 0; i < instance.jobCount; i++) {
-        job_index.emplace_back(0);
-        job_min_time.emplace_back(0);
-    }
+/**
+ * creates random solutions in parallel. The seeds of the rng streams are drawn from the instance before the threads
+ * start, so the result does not depend on the number of threads
+ * @param instance
+ * @param size number of solutions
+ * @param threads number of threads, 0: std::thread::hardware_concurrency
+ * @return solutions with makespan
+ */
+vector<Solution> Heuristics::randomPopulation(JSSPInstance &instance, int size, unsigned int threads) {
+    auto seeds = vector<unsigned int>(size);
+    for (auto &seed: seeds) seed = instance.getSeed();
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<unsigned int>(threads, std::max(size, 1));
 
-    while (std::accumulate(job_index.begin(), job_index.end(), 0) < instance.operationCount()) {
-        auto job_selected = dist(rng);
-        while (job_index[job_selected] >= instance.machineCount) {
-            job_selected = dist(rng);
+    auto solutions = vector<Solution>(size);
+    auto generate = [&instance, &seeds, &solutions, size, threads](unsigned int thread) {
+        auto scheduler = RandomScheduler(instance);
+        for (int i = static_cast<int>(thread); i < size; i += static_cast<int>(threads)) {
+            auto rng = std::mt19937(seeds[i]);
+            solutions[i].solution = scheduler.schedule(rng);
+            solutions[i].makespan = instance.calcMakespan(solutions[i].solution);
         }
-        auto jssp_instance_op = instance.instance[job_selected][job_index[job_selected]];
-        auto operation = MNode(job_selected, jssp_instance_op.duration);
-        auto start_time = machines[jssp_instance_op.machine].insert(std::make_shared<MNode>(operation), job_min_time[job_selected]);
-        job_min_time[job_selected] = start_time + jssp_instance_op.duration;
-        job_index[job_selected] += 1;
+    };
+    auto workers = vector<std::thread>();
+    for (unsigned int thread = 1; thread < threads; thread++) workers.emplace_back(generate, thread);
+    generate(0);
+    for (auto &worker: workers) worker.join();
+    return solutions;
+}
+
+/**
+ * creates a non delay solution with a single priority dispatching rule, ties are broken by the lower job number
+ * @param instance
+ * @param rule
+ * @return a solution (machine sequence)
+ */
+vector<vector<int>> Heuristics::dispatch(JSSPInstance const &instance, DispatchingRule rule) {
+    auto weights = std::array<double, dispatchingRuleCount>{};
+    weights[rule] = 1;
+    return dispatch(instance, weights);
+}
+
+/**
+ * creates a solution with a random mixture of the dispatching rules, each rule gets a random weight in [0, 1)
+ * @param instance
+ * @return a solution (machine sequence)
+ */
+vector<vector<int>> Heuristics::randomRuleMixture(JSSPInstance &instance) {
+    auto rng = std::mt19937(instance.getSeed());
+    std::uniform_real_distribution<double> dist(0, 1);
+    auto weights = std::array<double, dispatchingRuleCount>{};
+    for (auto &weight: weights) weight = dist(rng);
+    return dispatch(instance, weights);
+}
+
+/**
+ * non delay schedule generation: when a machine is idle, it starts the operation with the highest priority of the
+ * operations waiting for it. Waiting operations are kept in a heap for each machine, completions in a heap of events, so
+ * each operation is pushed and popped once from each: O(nm log n).
+ * the scores of the rules are normalized to about [-1, 1], so they can be mixed:
+ * spt -duration / max duration, lpt duration / max duration, mwkr remaining work / max job work,
+ * mor remaining operations / #machines, fdd_mwkr -fdd / (fdd + mwkr) (same order as fdd / mwkr)
+ * @param instance
+ * @param weights weight of each DispatchingRule
+ * @return a solution (machine sequence)
+ */
+vector<vector<int>> Heuristics::dispatch(JSSPInstance const &instance, std::array<double, dispatchingRuleCount> const &weights) {
+    int job_count = instance.jobCount;
+    int machine_count = instance.machineCount;
+    // remaining_work[job * (machine_count + 1) + index]: sum of the durations of the operations index.. of the job
+    auto remaining_work = vector<long long>(job_count * (machine_count + 1), 0);
+    int max_duration = 1;
+    long long max_work = 1;
+    for (int job = 0; job < job_count; job++) {
+        for (int index = machine_count - 1; index >= 0; index--) {
+            int duration = instance.instance[job][index].duration;
+            remaining_work[job * (machine_count + 1) + index] = remaining_work[job * (machine_count + 1) + index + 1] + duration;
+            max_duration = std::max(max_duration, duration);
+        }
+        max_work = std::max(max_work, remaining_work[job * (machine_count + 1)]);
     }
 
-    auto solution = vector<vector<int>>();
-    for (auto machine: machines) {
-        solution.emplace_back(machine.getSequence());
+    auto priority = [&](int job, int index) {
+        double duration = instance.instance[job][index].duration;
+        double work_left = static_cast<double>(remaining_work[job * (machine_count + 1) + index]);
+        double flow_due_date = static_cast<double>(remaining_work[job * (machine_count + 1)]) - work_left + duration;
+        return weights[spt] * -duration / max_duration
+               + weights[lpt] * duration / max_duration
+               + weights[mwkr] * work_left / static_cast<double>(max_work)
+               + weights[mor] * static_cast<double>(machine_count - index) / machine_count
+               + weights[fdd_mwkr] * -flow_due_date / (flow_due_date + work_left);
+    };
+    // highest priority first, lower job number first on ties
+    auto by_priority = [](std::pair<double, int> const &a, std::pair<double, int> const &b) {
+        return a.first < b.first || (a.first == b.first && a.second > b.second);
+    };
+    using WaitingQueue = std::priority_queue<std::pair<double, int>, vector<std::pair<double, int>>, decltype(by_priority)>;
+    auto waiting = vector<WaitingQueue>(machine_count, WaitingQueue(by_priority));
+    // completion events (end time, job), earliest first
+    auto completions = std::priority_queue<std::pair<long long, int>, vector<std::pair<long long, int>>, std::greater<>>();
+    auto next_index = vector<int>(job_count, 0);
+    auto busy = vector<bool>(machine_count, false);
+    auto solution = vector<vector<int>>(machine_count);
+    for (auto &machine: solution) machine.reserve(job_count);
+
+    auto start_next = [&](int machine, long long time) {
+        if (busy[machine] || waiting[machine].empty()) return;
+        int job = waiting[machine].top().second;
+        waiting[machine].pop();
+        solution[machine].emplace_back(job);
+        busy[machine] = true;
+        completions.emplace(time + instance.instance[job][next_index[job]].duration, job);
+    };
+
+    for (int job = 0; job < job_count; job++) {
+        waiting[instance.instance[job][0].machine].emplace(priority(job, 0), job);
+    }
+    for (int machine = 0; machine < machine_count; machine++) start_next(machine, 0);
+
+    auto touched = vector<int>();
+    while (!completions.empty()) {
+        long long time = completions.top().first;
+        touched.clear();
+        // release all operations which complete at time, before the idle machines choose
+        while (!completions.empty() && completions.top().first == time) {
+            int job = completions.top().second;
+            completions.pop();
+            int machine = instance.instance[job][next_index[job]].machine;
+            busy[machine] = false;
+            touched.emplace_back(machine);
+            if (++next_index[job] < machine_count) {
+                int next_machine = instance.instance[job][next_index[job]].machine;
+                waiting[next_machine].emplace(priority(job, next_index[job]), job);
+                touched.emplace_back(next_machine);
+            }
+        }
+        for (int machine: touched) start_next(machine, time);
     }
     return solution;
 }
+
+/**
+ * Carlier's branch and bound for 1|r_j,q_j|Lmax. The best sequence is evaluated with the original release and
+ * delivery times, the branching only tightens them
+ * @param release earliest start of each job (head)
+ * @param duration
+ * @param delivery time after the end of each job (tail)
+ * @param sequence result, order of the jobs
+ * @param node_limit
+ * @return max(C_j + q_j) of the sequence
+ */
+long long SingleMachineSolver::solve(vector<long long> const &_release, vector<long long> const &_duration,
+                                     vector<long long> const &_delivery, vector<int> &sequence, int node_limit) {
+    release = _release;
+    duration = _duration;
+    delivery = _delivery;
+    int job_count = static_cast<int>(release.size());
+    order.resize(job_count);
+    schrageSequence.resize(job_count);
+    schrageStart.resize(job_count);
+    upperBound = std::numeric_limits<long long>::max();
+    nodeCount = 0;
+    nodeLimit = node_limit;
+    branch();
+
+    sequence = bestSequence;
+    long long time = 0, value = 0;
+    for (int job: sequence) {
+        time = std::max(time, _release[job]) + _duration[job];
+        value = std::max(value, time + _delivery[job]);
+    }
+    return value;
+}
+
+/**
+ * Schrage's rule with the current release and delivery times, writes schrageSequence and schrageStart
+ * @return max(C_j + q_j)
+ */
+long long SingleMachineSolver::schrage() {
+    int job_count = static_cast<int>(order.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](int a, int b) { return release[a] < release[b]; });
+    // longest delivery first, earlier release first on ties
+    auto by_delivery = [this](int a, int b) {
+        return delivery[a] < delivery[b] || (delivery[a] == delivery[b] && release[a] > release[b]);
+    };
+    auto ready = std::priority_queue<int, vector<int>, decltype(by_delivery)>(by_delivery);
+    long long time = 0, value = 0;
+    int next = 0;
+    for (int pos = 0; pos < job_count; pos++) {
+        if (ready.empty()) time = std::max(time, release[order[next]]);
+        while (next < job_count && release[order[next]] <= time) ready.push(order[next++]);
+        int job = ready.top();
+        ready.pop();
+        schrageSequence[pos] = job;
+        schrageStart[pos] = time;
+        time += duration[job];
+        value = std::max(value, time + delivery[job]);
+    }
+    return value;
+}
+
+/**
+ * one node of the branch and bound: the critical block a..b of the Schrage sequence defines the value. If a job c of the
+ * block has a shorter delivery time than b, the jobs J after c are branched on: c after all of J (release of c raised)
+ * or c before all of J (delivery of c raised). Otherwise the Schrage sequence is optimal for the node
+ */
+void SingleMachineSolver::branch() {
+    if (++nodeCount > nodeLimit) return;
+    long long value = schrage();
+    if (value < upperBound) {
+        upperBound = value;
+        bestSequence = schrageSequence;
+    }
+
+    int b_pos = 0;
+    for (int pos = 0; pos < static_cast<int>(order.size()); pos++) {
+        int job = schrageSequence[pos];
+        if (schrageStart[pos] + duration[job] + delivery[job] == value) b_pos = pos;
+    }
+    int b = schrageSequence[b_pos];
+    // a: first job of the block without idle time before b, which starts at its release time
+    int a_pos = b_pos;
+    long long block_duration = 0;
+    for (int pos = b_pos; pos >= 0; pos--) {
+        block_duration += duration[schrageSequence[pos]];
+        if (release[schrageSequence[pos]] + block_duration + delivery[b] == value) a_pos = pos;
+        if (pos > 0 && schrageStart[pos - 1] + duration[schrageSequence[pos - 1]] < schrageStart[pos]) break;
+    }
+    int c_pos = -1;
+    for (int pos = b_pos - 1; pos >= a_pos; pos--) {
+        if (delivery[schrageSequence[pos]] < delivery[b]) {
+            c_pos = pos;
+            break;
+        }
+    }
+    if (c_pos < 0) return;
+
+    int c = schrageSequence[c_pos];
+    long long block_release = std::numeric_limits<long long>::max();
+    long long block_delivery = std::numeric_limits<long long>::max();
+    block_duration = 0;
+    for (int pos = c_pos + 1; pos <= b_pos; pos++) {
+        int job = schrageSequence[pos];
+        block_release = std::min(block_release, release[job]);
+        block_delivery = std::min(block_delivery, delivery[job]);
+        block_duration += duration[job];
+    }
+    long long block_bound = block_release + block_duration + block_delivery;
+    auto lower_bound = [&]() {
+        return std::max(block_bound, std::min(block_release, release[c]) + block_duration + duration[c]
+                                     + std::min(block_delivery, delivery[c]));
+    };
+
+    long long old_release = release[c];
+    release[c] = std::max(release[c], block_release + block_duration);
+    if (lower_bound() < upperBound) branch();
+    release[c] = old_release;
+
+    long long old_delivery = delivery[c];
+    delivery[c] = std::max(delivery[c], block_duration + block_delivery);
+    if (lower_bound() < upperBound) branch();
+    delivery[c] = old_delivery;
+}
+
+/**
+ * shifting bottleneck heuristic (Adams, Balas and Zawack): starts with the job arcs of the disjunctive graph only. Each
+ * iteration solves the single machine problem of every unsequenced machine, with the heads of the operations as release
+ * and the tails as delivery times, and sequences the machine with the largest value (the bottleneck). Afterwards the
+ * sequenced machines are reoptimized one by one: removed from the graph, solved again and inserted with the new sequence,
+ * if its value is below the current makespan. Heads and tails are computed by calcHeadsAndTails, like in the tabu search
+ * @param instance
+ * @param reoptimization_rounds passes over the sequenced machines after each iteration
+ * @return solution with makespan
+ */
+Solution Heuristics::shiftingBottleneck(JSSPInstance const &instance, int reoptimization_rounds) {
+    using Node = BasicNode<int, int>;
+    int const nil = -1;
+    int job_count = instance.jobCount;
+    int machine_count = instance.machineCount;
+    int op_count = job_count * machine_count;
+
+    auto graph = vector<Node>(op_count);
+    // operation_ids[job * machine_count + machine]: id of the operation of the job on the machine
+    auto operation_ids = vector<int>(op_count);
+    for (int job = 0; job < job_count; job++) {
+        for (int index = 0; index < machine_count; index++) {
+            int op = job * machine_count + index;
+            auto const &operation = instance.instance[job][index];
+            graph[op] = Node{index > 0 ? op - 1 : nil, nil, index < machine_count - 1 ? op + 1 : nil, nil,
+                             operation.machine, job, 0, operation.duration, 0};
+            operation_ids[job * machine_count + operation.machine] = op;
+        }
+    }
+    auto topological_order = vector<int>(op_count);
+    auto predecessor_count = vector<uint8_t>(op_count);
+    auto heads_and_tails = [&]() {
+        return calcHeadsAndTails(graph.data(), op_count, nil, topological_order.data(), predecessor_count.data());
+    };
+    auto link = [&](int machine, vector<int> const &jobs) {
+        for (int pos = 0; pos < job_count; pos++) {
+            auto &node = graph[operation_ids[jobs[pos] * machine_count + machine]];
+            node.machPredecessor = pos > 0 ? operation_ids[jobs[pos - 1] * machine_count + machine] : nil;
+            node.machSuccessor = pos < job_count - 1 ? operation_ids[jobs[pos + 1] * machine_count + machine] : nil;
+        }
+    };
+    auto unlink = [&](int machine) {
+        for (int job = 0; job < job_count; job++) {
+            auto &node = graph[operation_ids[job * machine_count + machine]];
+            node.machPredecessor = nil;
+            node.machSuccessor = nil;
+        }
+    };
+
+    SingleMachineSolver solver;
+    auto release = vector<long long>(job_count);
+    auto duration = vector<long long>(job_count);
+    auto delivery = vector<long long>(job_count);
+    // single machine problem of a machine with the current heads and tails
+    auto solve = [&](int machine, vector<int> &jobs, int node_limit) {
+        for (int job = 0; job < job_count; job++) {
+            auto const &node = graph[operation_ids[job * machine_count + machine]];
+            release[job] = node.start;
+            duration[job] = node.duration;
+            delivery[job] = node.lenToN;
+        }
+        return solver.solve(release, duration, delivery, jobs, node_limit);
+    };
+    // links the sequence, if it closes a cycle (possible for ties of the branch and bound) the Schrage sequence instead,
+    // which respects all paths between the operations of the machine. Heads and tails have to be up to date
+    auto insert = [&](int machine, vector<int> &jobs) {
+        auto schrage_jobs = vector<int>();
+        solve(machine, schrage_jobs, 1);
+        link(machine, jobs);
+        int makespan = heads_and_tails();
+        if (makespan >= 0) return makespan;
+        jobs = schrage_jobs;
+        link(machine, jobs);
+        return heads_and_tails();
+    };
+
+    auto sequences = vector<vector<int>>(machine_count);
+    auto sequenced = vector<int>();
+    int makespan = heads_and_tails();
+    auto jobs = vector<int>();
+    auto bottleneck_jobs = vector<int>();
+    while (static_cast<int>(sequenced.size()) < machine_count) {
+        // a reoptimization which kept the old sequence leaves the heads and tails of the graph without it
+        heads_and_tails();
+        int bottleneck = -1;
+        long long bottleneck_value = -1;
+        for (int machine = 0; machine < machine_count; machine++) {
+            if (!sequences[machine].empty()) continue;
+            long long value = solve(machine, jobs, 1000);
+            if (value > bottleneck_value) {
+                bottleneck = machine;
+                bottleneck_value = value;
+                bottleneck_jobs = jobs;
+            }
+        }
+        makespan = insert(bottleneck, bottleneck_jobs);
+        sequences[bottleneck] = bottleneck_jobs;
+        sequenced.emplace_back(bottleneck);
+
+        for (int round = 0; round < reoptimization_rounds; round++) {
+            bool improved = false;
+            for (int machine: sequenced) {
+                unlink(machine);
+                heads_and_tails();
+                long long value = solve(machine, jobs, 1000);
+                int new_makespan = value < makespan ? insert(machine, jobs) : -1;
+                // the one machine value is only a bound, keep the new sequence if the makespan of the graph is not worse
+                if (new_makespan >= 0 && new_makespan <= makespan) {
+                    if (new_makespan < makespan) improved = true;
+                    makespan = new_makespan;
+                    sequences[machine] = jobs;
+                } else {
+                    link(machine, sequences[machine]);
+                }
+            }
+            if (!improved) break;
+        }
+    }
+    return Solution{sequences, makespan};
+}
+
+/**
+ * start population: one solution of each dispatching rule and the shifting bottleneck solution (as far as size allows),
+ * filled up with random rule mixtures. Solutions already in the population are replaced by random solutions, so the population stays diverse
+ * @param instance
+ * @param size number of solutions
+ * @return solutions with makespan
+ */
+vector<Solution> Heuristics::population(JSSPInstance &instance, int size) {
+    auto solutions = vector<Solution>();
+    for (int i = 0; i < size; i++) {
+        vector<vector<int>> solution;
+        if (i < dispatchingRuleCount) solution = dispatch(instance, static_cast<DispatchingRule>(i));
+        else if (i == dispatchingRuleCount) solution = shiftingBottleneck(instance).solution;
+        else solution = randomRuleMixture(instance);
+        bool duplicate = std::any_of(solutions.begin(), solutions.end(), [&solution](Solution const &s) { return s.solution == solution; });
+        if (duplicate) solution = random(instance);
+        int makespan = instance.calcMakespan(solution);
+        solutions.emplace_back(Solution{std::move(solution), makespan});
+    }
+    return solutions;
+}
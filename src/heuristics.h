@@ -2,31 +2,107 @@
 #define HYBRID_EVO_ALGORITHM_HEURISTICS_H
 
 #include <memory>
+#include <array>
 #include "jssp.h"
+#include "disjunctive_graph.h"
 
-struct MNode {
-    MNode(unsigned int _job, unsigned int _duration) : job(_job), duration(_duration) {};
-    std::shared_ptr<MNode> next;
-    std::shared_ptr<MNode> previous;
-    unsigned int job;
-    unsigned int duration;
-    unsigned int start;
-    unsigned int end() const { return start + duration; };
-};
+/**
+ * generator of random solutions, see Heuristics::random. All buffers are flat arrays with a fixed stride of #jobs per
+ * machine, allocated once, so one scheduler generates any number of solutions without allocations (besides the result)
+ */
+class RandomScheduler {
+public:
+    explicit RandomScheduler(JSSPInstance const &instance);
+
+    // creates a random solution: random open jobs insert their next operation into the earliest fitting idle gap
+    vector<vector<int>> schedule(std::mt19937 &rng);
 
-class Machine {
 private:
-    std::shared_ptr<MNode> firstOp;
+    JSSPInstance const &instance;
+    int const jobCount, machineCount;
+    // scheduled operations of machine m at [m * jobCount, m * jobCount + scheduledCount[m]), ordered by start time
+    vector<int> sequence;
+    vector<long long> start;
+    vector<long long> end;
+    vector<int> scheduledCount;
+    // longest idle gap between the operations of each machine, a pre-filter: the gaps of a machine are only scanned
+    // (linearly, see insert) if the operation fits into the longest one
+    vector<long long> longestGap;
+    // open jobs at [0, openCount), a finished job is swapped with the last open job
+    vector<int> openJobs;
+    int openCount = 0;
+    vector<int> nextOperation;
+    vector<long long> jobReady;
+
+    // insert an operation as early as possible, not before min_time, return its start time
+    long long insert(int machine, int job, int duration, long long min_time);
+};
 
+/**
+ * solver of the single machine problem with release and delivery times (1|r_j,q_j|Lmax): minimizes max(C_j + q_j) over
+ * all jobs. Carlier's branch and bound, each node is solved heuristically by Schrage's rule, which also yields the
+ * critical block to branch on. Used for the machine subproblems of Heuristics::shiftingBottleneck
+ */
+class SingleMachineSolver {
 public:
-    unsigned int insert(const std::shared_ptr<MNode>& operation, unsigned int min_time);
-    vector<int> getSequence();
+    /**
+     * sequence of the jobs with the smallest max(C_j + q_j) found in at most node_limit branch and bound nodes
+     * (optimal, if the limit is not reached). node_limit 1: Schrage's rule only
+     * @return max(C_j + q_j) of the sequence
+     */
+    long long solve(vector<long long> const &release, vector<long long> const &duration, vector<long long> const &delivery,
+                    vector<int> &sequence, int node_limit = 1000);
+
+private:
+    // release and delivery times are tightened by the branching, restored on backtracking
+    vector<long long> release, duration, delivery;
+    vector<int> order;
+    vector<int> schrageSequence;
+    vector<long long> schrageStart;
+    vector<int> bestSequence;
+    long long upperBound = 0;
+    int nodeCount = 0, nodeLimit = 0;
+
+    // Schrage's rule: whenever the machine is free, start the released job with the longest delivery time
+    long long schrage();
+
+    void branch();
 };
 
+/**
+ * priority dispatching rules, an idle machine starts the waiting operation with the highest priority
+ * spt: shortest processing time of the operation
+ * lpt: longest processing time of the operation
+ * mwkr: most work remaining, sum of the durations of the unscheduled operations of the job
+ * mor: most operations remaining in the job
+ * fdd_mwkr: smallest ratio of flow due date (work of the job up to the end of the operation) to work remaining
+ */
+enum DispatchingRule {spt, lpt, mwkr, mor, fdd_mwkr};
+constexpr int dispatchingRuleCount = 5;
+
 class Heuristics {
 public:
-    // creates a random semi active solution
+    // creates a random active solution, see RandomScheduler
     static vector<vector<int>> random(JSSPInstance &instance);
+
+    // creates size random solutions with makespan in parallel, each with its own rng stream. threads 0: all cores
+    static vector<Solution> randomPopulation(JSSPInstance &instance, int size, unsigned int threads = 0);
+
+    // creates a non delay solution with a priority dispatching rule
+    static vector<vector<int>> dispatch(JSSPInstance const &instance, DispatchingRule rule);
+
+    // creates a non delay solution with a random weighted mixture of all dispatching rules
+    static vector<vector<int>> randomRuleMixture(JSSPInstance &instance);
+
+    // creates a solution with the shifting bottleneck heuristic, the machines are sequenced by SingleMachineSolver
+    static Solution shiftingBottleneck(JSSPInstance const &instance, int reoptimization_rounds = 2);
+
+    // start solutions for MemeticAlgorithm::optimizePopulation: all dispatching rules, shifting bottleneck, then random rule mixtures
+    static vector<Solution> population(JSSPInstance &instance, int size);
+
+private:
+    // non delay scheduling with the priority sum_r weights[r] * score_r, see DispatchingRule
+    static vector<vector<int>> dispatch(JSSPInstance const &instance, std::array<double, dispatchingRuleCount> const &weights);
 };
 
 
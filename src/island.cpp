@@ -0,0 +1,281 @@
+#include "island.h"
+#include <algorithm>
+#include <iostream>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+/**
+ * closes all sockets of the island
+ */
+Island::~Island() {
+    for (int socket: outSockets) close(socket);
+    for (int socket: inSockets) close(socket);
+}
+
+/**
+ * send the emigrants to every outgoing neighbour and collect the immigrants of all incoming neighbours.
+ * never blocks: a full receiver queue or a finished neighbour drops the message
+ * @param emigrants elite solutions of this island
+ * @return all solutions received since the last call
+ */
+vector<Solution> Island::exchange(vector<Solution> const &emigrants) {
+    auto message = IslandModel::serialize(emigrants);
+    auto bytes = message.size() * sizeof(int);
+    if (bytes <= static_cast<size_t>(maxMessageSize)) {
+        for (int socket: outSockets) {
+            send(socket, message.data(), bytes, MSG_DONTWAIT | MSG_NOSIGNAL);
+        }
+    }
+
+    auto immigrants = vector<Solution>();
+    auto buffer = vector<int>(maxMessageSize / sizeof(int) + 1);
+    for (int socket: inSockets) {
+        while (true) {
+            auto received = recv(socket, buffer.data(), buffer.size() * sizeof(int), MSG_DONTWAIT);
+            if (received <= 0) break;
+            for (auto &solution: IslandModel::deserialize(buffer.data(), received / sizeof(int))) {
+                immigrants.emplace_back(std::move(solution));
+            }
+        }
+    }
+    return immigrants;
+}
+
+/**
+ * list of islands the given island sends its elite to
+ * @param island index of the sending island
+ * @param config
+ * @return indices of the receiving islands
+ */
+vector<int> IslandModel::migrationTargets(int island, IslandConfig const &config) {
+    auto targets = vector<int>();
+    if (config.islandCount < 2) return targets;
+    if (config.topology == ring) {
+        targets.emplace_back((island + 1) % config.islandCount);
+    } else {
+        for (int i = 0; i < config.islandCount; i++) {
+            if (i != island) targets.emplace_back(i);
+        }
+    }
+    return targets;
+}
+
+/**
+ * serialize solutions to a flat int message: [count, {makespan, #machines, {#jobs, jobs...}...}...]
+ * @param solutions
+ * @return message
+ */
+vector<int> IslandModel::serialize(vector<Solution> const &solutions) {
+    auto message = vector<int>{static_cast<int>(solutions.size())};
+    for (auto const &solution: solutions) {
+        message.emplace_back(solution.makespan);
+        message.emplace_back(static_cast<int>(solution.solution.size()));
+        for (auto const &machine: solution.solution) {
+            message.emplace_back(static_cast<int>(machine.size()));
+            message.insert(message.end(), machine.begin(), machine.end());
+        }
+    }
+    return message;
+}
+
+/**
+ * inverse of IslandModel::serialize, truncated or malformed messages return the complete solutions before the defect
+ * @param message
+ * @param size number of ints in the message
+ * @return solutions
+ */
+vector<Solution> IslandModel::deserialize(int const *message, size_t size) {
+    auto solutions = vector<Solution>();
+    if (size == 0) return solutions;
+    size_t pos = 1;
+    for (int s = 0; s < message[0]; s++) {
+        if (pos + 2 > size) break;
+        // each machine takes at least its length, larger or negative counts come from a malformed message
+        int machine_count = message[pos + 1];
+        if (machine_count < 0 || static_cast<size_t>(machine_count) > size - pos - 2) break;
+        auto solution = Solution{vector<vector<int>>(machine_count), message[pos]};
+        pos += 2;
+        for (auto &machine: solution.solution) {
+            if (pos >= size) return solutions;
+            int job_count = message[pos];
+            if (job_count < 0 || static_cast<size_t>(job_count) > size - pos - 1) return solutions;
+            machine.assign(message + pos + 1, message + pos + 1 + job_count);
+            pos += 1 + job_count;
+        }
+        solutions.emplace_back(std::move(solution));
+    }
+    return solutions;
+}
+
+/**
+ * write a BMResult to a pipe: header with the sizes and the lower bound, serialized solution, then the history as
+ * (seconds, makespan) pairs
+ * @param fd
+ * @param result
+ */
+void IslandModel::writeResult(int fd, BMResult const &result) {
+    auto message = serialize({Solution{result.solution, result.makespan}});
+    auto header = vector<size_t>{message.size(), result.history.size(), static_cast<size_t>(result.lowerBound)};
+    auto times = vector<double>();
+    auto makespans = vector<int>();
+    for (auto const &entry: result.history) {
+        times.emplace_back(std::get<0>(entry));
+        makespans.emplace_back(std::get<1>(entry));
+    }
+    auto write_all = [fd](void const *data, size_t bytes) {
+        auto ptr = static_cast<char const *>(data);
+        while (bytes > 0) {
+            auto written = write(fd, ptr, bytes);
+            if (written < 0 && errno == EINTR) continue;
+            if (written <= 0) return;
+            ptr += written;
+            bytes -= written;
+        }
+    };
+    write_all(header.data(), header.size() * sizeof(size_t));
+    write_all(message.data(), message.size() * sizeof(int));
+    write_all(times.data(), times.size() * sizeof(double));
+    write_all(makespans.data(), makespans.size() * sizeof(int));
+}
+
+/**
+ * read a BMResult written by IslandModel::writeResult
+ * @param fd
+ * @param result
+ * @return false if the island terminated without result
+ */
+bool IslandModel::readResult(int fd, BMResult &result) {
+    auto read_all = [fd](void *data, size_t bytes) {
+        auto ptr = static_cast<char *>(data);
+        while (bytes > 0) {
+            auto received = read(fd, ptr, bytes);
+            if (received < 0 && errno == EINTR) continue;
+            if (received <= 0) return false;
+            ptr += received;
+            bytes -= received;
+        }
+        return true;
+    };
+    auto header = vector<size_t>(3);
+    if (!read_all(header.data(), header.size() * sizeof(size_t))) return false;
+    auto message = vector<int>(header[0]);
+    auto times = vector<double>(header[1]);
+    auto makespans = vector<int>(header[1]);
+    if (!read_all(message.data(), message.size() * sizeof(int))
+        || !read_all(times.data(), times.size() * sizeof(double))
+        || !read_all(makespans.data(), makespans.size() * sizeof(int))) return false;
+
+    auto solutions = deserialize(message.data(), message.size());
+    if (solutions.empty()) return false;
+    int lower_bound = static_cast<int>(header[2]);
+    result = BMResult{solutions[0].solution, solutions[0].makespan, vector<std::tuple<double,int>>(), lower_bound,
+                      relativeGap(solutions[0].makespan, lower_bound)};
+    for (size_t i = 0; i < times.size(); i++) {
+        result.history.emplace_back(std::tuple{times[i], makespans[i]});
+    }
+    return true;
+}
+
+/**
+ * runs the memetic algorithm of one island process with migration enabled
+ * @param island connected island endpoint
+ * @param instance_path
+ * @param config
+ * @param time_limit
+ * @param lower_bound
+ * @param seed seed of this island
+ * @param result_pipe write end of the result pipe
+ */
+void IslandModel::runIsland(Island &island, string &instance_path, IslandConfig const &config, int time_limit,
+                            int lower_bound, int seed, int result_pipe) {
+    JSSPInstance instance = JSSPInstance(instance_path, seed);
+    MemeticAlgorithm mem = MemeticAlgorithm(instance, config.populationSize, config.tabuSearchIterations);
+    // each island is one process on its own core
+    mem.setThreads(1);
+    mem.setMigration(config.migrationInterval, config.eliteCount,
+                     [&island](vector<Solution> const &emigrants) { return island.exchange(emigrants); });
+    BMResult result = mem.optimize(time_limit, lower_bound);
+    writeResult(result_pipe, result);
+}
+
+/**
+ * local launcher of the island model: forks one process per island, connects them according to the topology and
+ * returns the best result of all islands. POSIX only.
+ * @param instance_path
+ * @param config
+ * @param time_limit maximum runtime of each island - soft limit
+ * @param lower_bound or lb for an early stop
+ * @param seed base seed, island i uses seed + i. random if 0
+ * @return best result found by any island, history of this island
+ */
+BMResult IslandModel::launchLocal(string instance_path, IslandConfig const &config, int time_limit, int lower_bound, int seed) {
+    JSSPInstance instance = JSSPInstance(instance_path);
+    if (seed == 0) seed = static_cast<int>(instance.getSeed());
+    int max_message_size = static_cast<int>(sizeof(int)) *
+            (1 + config.eliteCount * (2 + instance.machineCount + instance.operationCount()));
+
+    // one connected datagram socket pair per directed edge: [0] sending side, [1] receiving side
+    auto out_sockets = vector<vector<int>>(config.islandCount);
+    auto in_sockets = vector<vector<int>>(config.islandCount);
+    for (int i = 0; i < config.islandCount; i++) {
+        for (int target: migrationTargets(i, config)) {
+            int sockets[2];
+            if (socketpair(AF_UNIX, SOCK_DGRAM, 0, sockets) != 0) {
+                std::cout << "Could not create migration sockets. Terminating..." << std::endl;
+                exit(1);
+            }
+            out_sockets[i].emplace_back(sockets[0]);
+            in_sockets[target].emplace_back(sockets[1]);
+        }
+    }
+
+    auto pids = vector<pid_t>();
+    auto result_pipes = vector<int>();
+    for (int i = 0; i < config.islandCount; i++) {
+        int result_pipe[2];
+        if (pipe(result_pipe) != 0) {
+            std::cout << "Could not create result pipe. Terminating..." << std::endl;
+            exit(1);
+        }
+        std::cout.flush();
+        pid_t pid = fork();
+        if (pid < 0) {
+            std::cout << "Could not start island process. Terminating..." << std::endl;
+            exit(1);
+        }
+        if (pid == 0) {
+            // island process: keep only the own endpoints
+            close(result_pipe[0]);
+            for (int r: result_pipes) close(r);
+            for (int other = 0; other < config.islandCount; other++) {
+                if (other == i) continue;
+                for (int socket: out_sockets[other]) close(socket);
+                for (int socket: in_sockets[other]) close(socket);
+            }
+            {
+                Island island = Island(i, out_sockets[i], in_sockets[i], max_message_size);
+                runIsland(island, instance_path, config, time_limit, lower_bound, seed + i, result_pipe[1]);
+            }
+            close(result_pipe[1]);
+            _exit(0);
+        }
+        close(result_pipe[1]);
+        pids.emplace_back(pid);
+        result_pipes.emplace_back(result_pipe[0]);
+    }
+    for (auto &sockets: out_sockets) for (int socket: sockets) close(socket);
+    for (auto &sockets: in_sockets) for (int socket: sockets) close(socket);
+
+    auto best = BMResult{vector<vector<int>>(), INT32_MAX, vector<std::tuple<double,int>>()};
+    for (int i = 0; i < config.islandCount; i++) {
+        BMResult result;
+        if (readResult(result_pipes[i], result) && result.makespan < best.makespan) {
+            best = std::move(result);
+        }
+        close(result_pipes[i]);
+    }
+    for (pid_t pid: pids) waitpid(pid, nullptr, 0);
+    return best;
+}
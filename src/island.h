@@ -0,0 +1,78 @@
+#ifndef HYBRID_EVO_ALGORITHM_ISLAND_H
+#define HYBRID_EVO_ALGORITHM_ISLAND_H
+
+#include "jssp.h"
+#include "mem.h"
+
+/**
+ * which islands receive the elite of an island on migration
+ * ring: island i sends to island (i + 1) % n
+ * fully_connected: island i sends to every other island
+ */
+enum MigrationTopology {ring, fully_connected};
+
+/**
+ * configuration of the island model
+ */
+struct IslandConfig {
+    // number of islands (= processes) started by the local launcher
+    int islandCount = 4;
+    // number of memetic generations between two migrations
+    int migrationInterval = 10;
+    // number of best solutions each island sends on migration
+    int eliteCount = 2;
+    MigrationTopology topology = ring;
+    // parameters of the MemeticAlgorithm on each island
+    int populationSize = 30;
+    int tabuSearchIterations = 12000;
+};
+
+/**
+ * one island of the island model: endpoint for the migration of elite solutions to and from the neighbouring islands.
+ * the transport are connected unix domain datagram sockets, one per directed edge of the topology, which stand in for a
+ * network connection. Sending and receiving never blocks: immigrants are merged when they arrive, emigrants are dropped
+ * if the receiver is too slow or already finished.
+ */
+class Island {
+public:
+    Island(int id, vector<int> out_sockets, vector<int> in_sockets, int max_message_size):
+            id(id), outSockets(std::move(out_sockets)), inSockets(std::move(in_sockets)), maxMessageSize(max_message_size) {};
+
+    ~Island();
+
+    // send the emigrants to all outgoing neighbours and return all immigrants which arrived since the last call
+    vector<Solution> exchange(vector<Solution> const &emigrants);
+
+    const int id;
+
+private:
+    vector<int> outSockets;
+    vector<int> inSockets;
+    // size of the receive buffer in bytes
+    const int maxMessageSize;
+};
+
+class IslandModel {
+public:
+    // list the islands which receive the elite of island from, see MigrationTopology
+    static vector<int> migrationTargets(int island, IslandConfig const &config);
+
+    // fork config.islandCount processes, each running a MemeticAlgorithm on the instance, and return the best result
+    static BMResult launchLocal(string instance_path, IslandConfig const &config, int time_limit, int lower_bound=0, int seed=0);
+
+    // serialization of solutions for the transport between processes
+    static vector<int> serialize(vector<Solution> const &solutions);
+    static vector<Solution> deserialize(int const *message, size_t size);
+
+private:
+    // body of a forked island process, writes the result of the island to result_pipe
+    static void runIsland(Island &island, string &instance_path, IslandConfig const &config, int time_limit,
+                          int lower_bound, int seed, int result_pipe);
+
+    // result transport between island process and launcher
+    static void writeResult(int fd, BMResult const &result);
+    static bool readResult(int fd, BMResult &result);
+};
+
+
+#endif //HYBRID_EVO_ALGORITHM_ISLAND_H
@@ -1,8 +1,11 @@
 #include "jssp.h"
+#include "layout.h"
 #include <fstream>
 #include <iostream>
 #include <algorithm>
 #include <random>
+#include <limits>
+#include <queue>
 
 /**
  * read in an instance in standard format described in instances/README.md
@@ -66,8 +69,20 @@ vector<vector<Operation>> JSSPInstance::readInstance(string &filename) {
  * @return
  */
 int JSSPInstance::calcMakespan(vector<vector<int>> const &solution) const {
-    vector<int> makespan_machine = vector<int>(solution.size());
-    vector<int> sol_ptr = vector<int>(solution.size());
+    return calcMakespan(FlatSolution(solution));
+}
+
+/**
+ * calculate the exact makespan for a solution of this instance
+ * @warning: infeasible solutions will cause undefined behavior
+ * @param solution
+ * @return
+ */
+template<typename IndexT, typename TimeT>
+int JSSPInstance::calcMakespan(BasicFlatSolution<IndexT, TimeT> const &solution) const {
+    int machine_count = solution.machineCount();
+    vector<int> makespan_machine = vector<int>(machine_count);
+    vector<int> sol_ptr = vector<int>(machine_count);
     vector<int> makespan_job = vector<int>(instance.size());
     vector<int> job_ptr = vector<int>(instance.size());
 
@@ -75,9 +90,9 @@ int JSSPInstance::calcMakespan(vector<vector<int>> const &solution) const {
     long error_detection = 0;
     while (ops_left > 0) {
         error_detection += 1;
-        for (int machine = 0; machine < solution.size(); machine++) {
-            if (sol_ptr[machine] == solution[machine].size()) continue;
-            int job = solution[machine][sol_ptr[machine]];
+        for (int machine = 0; machine < machine_count; machine++) {
+            if (sol_ptr[machine] == solution.stride) continue;
+            int job = solution.machine(machine)[sol_ptr[machine]];
             if (instance[job][job_ptr[job]].machine == machine) {
                 int makespan = std::max(makespan_job[job], makespan_machine[machine]) +
                                instance[job][job_ptr[job]].duration;
@@ -102,13 +117,31 @@ int JSSPInstance::calcMakespan(vector<vector<int>> const &solution) const {
  * warning: infeasible solutions will be altered to be feasible
  * @param solution
  * @param _seed random generator seed
+ * @param memory memory resource for the scratch memory
  * @return makespan of solution
  */
-int JSSPInstance::calcMakespanAndFixSolution(vector<vector<int>>& solution, unsigned int _seed) const {
-    vector<int> makespan_machine = vector<int>(solution.size());
-    vector<int> sol_ptr = vector<int>(solution.size());
-    vector<int> makespan_job = vector<int>(instance.size());
-    vector<int> job_ptr = vector<int>(instance.size());
+int JSSPInstance::calcMakespanAndFixSolution(vector<vector<int>>& solution, unsigned int _seed, std::pmr::memory_resource *memory) const {
+    auto flat_solution = FlatSolution(solution);
+    int makespan = calcMakespanAndFixSolution(flat_solution, _seed, memory);
+    solution = flat_solution.toNested();
+    return makespan;
+}
+
+/**
+ * calculate the exact makespan for a solution of this instance
+ * warning: infeasible solutions will be altered to be feasible
+ * @param solution
+ * @param _seed random generator seed
+ * @param memory memory resource for the scratch memory
+ * @return makespan of solution
+ */
+template<typename IndexT, typename TimeT>
+int JSSPInstance::calcMakespanAndFixSolution(BasicFlatSolution<IndexT, TimeT> &solution, unsigned int _seed, std::pmr::memory_resource *memory) const {
+    int machine_count = solution.machineCount();
+    auto makespan_machine = std::pmr::vector<int>(machine_count, memory);
+    auto sol_ptr = std::pmr::vector<int>(machine_count, memory);
+    auto makespan_job = std::pmr::vector<int>(instance.size(), memory);
+    auto job_ptr = std::pmr::vector<int>(instance.size(), memory);
 
     std::mt19937 local_rnd;
     if (_seed == 0) {
@@ -121,9 +154,9 @@ int JSSPInstance::calcMakespanAndFixSolution(vector<vector<int>>& solution, unsi
     int infeasibility_counter = 0;
 
     while (op_count > 0) {
-        for (int machine = 0; machine < solution.size(); machine++) {
-            if (sol_ptr[machine] == solution[machine].size()) continue;
-            int job = solution[machine][sol_ptr[machine]];
+        for (int machine = 0; machine < machine_count; machine++) {
+            if (sol_ptr[machine] == solution.stride) continue;
+            int job = solution.machine(machine)[sol_ptr[machine]];
             if (instance[job][job_ptr[job]].machine == machine) {
                 int makespan = std::max(makespan_job[job], makespan_machine[machine]) +
                                instance[job][job_ptr[job]].duration;
@@ -137,11 +170,67 @@ int JSSPInstance::calcMakespanAndFixSolution(vector<vector<int>>& solution, unsi
                 ++infeasibility_counter;
             }
         }
-        if (infeasibility_counter > solution.size()) {
-            recover_solution(solution, sol_ptr, job_ptr, local_rnd);
+        if (infeasibility_counter > machine_count) {
+            recover_solution(solution, sol_ptr, job_ptr, local_rnd, memory);
         }
     }
-    return *std::max_element(makespan_machine.begin(), makespan_machine.end());
+    int makespan = *std::max_element(makespan_machine.begin(), makespan_machine.end());
+    solution.makespan = static_cast<TimeT>(makespan);
+    return makespan;
+}
+
+/**
+ * Giffler-Thompson decoder: rebuilds the solution as an active schedule, using the machine sequences of the (possibly
+ * infeasible) solution as priorities. Each step takes the unscheduled operation with the earliest completion time, the
+ * conflict set are the operations on its machine which can start before that completion, and the one which comes first
+ * in the machine sequence of the solution is scheduled. The solution keeps its order as far as it is feasible and active
+ * warning: the solution is overwritten with the decoded one
+ * @param solution
+ * @param memory memory resource for the scratch memory
+ * @return makespan of the decoded solution
+ */
+template<typename IndexT, typename TimeT>
+int JSSPInstance::decodeActiveSchedule(BasicFlatSolution<IndexT, TimeT> &solution, std::pmr::memory_resource *memory) const {
+    int machine_count = solution.machineCount();
+    int job_count = solution.stride;
+    // priority[machine * job_count + job]: position of the job in the machine sequence, lower first
+    auto priority = std::pmr::vector<int>(machine_count * job_count, memory);
+    for (int machine = 0; machine < machine_count; machine++) {
+        for (int pos = 0; pos < job_count; pos++) priority[machine * job_count + solution.machine(machine)[pos]] = pos;
+    }
+    auto machine_ready = std::pmr::vector<int>(machine_count, memory);
+    auto scheduled_count = std::pmr::vector<int>(machine_count, memory);
+    auto job_ready = std::pmr::vector<int>(job_count, memory);
+    auto job_ptr = std::pmr::vector<int>(job_count, memory);
+
+    int makespan = 0;
+    for (int op_count = operationCount(); op_count > 0; op_count--) {
+        int min_completion = std::numeric_limits<int>::max();
+        int machine = 0;
+        for (int job = 0; job < job_count; job++) {
+            if (job_ptr[job] == machine_count) continue;
+            auto const &operation = instance[job][job_ptr[job]];
+            int completion = std::max(job_ready[job], machine_ready[operation.machine]) + operation.duration;
+            if (completion < min_completion) {
+                min_completion = completion;
+                machine = operation.machine;
+            }
+        }
+        int selected = -1;
+        for (int job = 0; job < job_count; job++) {
+            if (job_ptr[job] == machine_count || instance[job][job_ptr[job]].machine != machine) continue;
+            if (std::max(job_ready[job], machine_ready[machine]) >= min_completion) continue;
+            if (selected < 0 || priority[machine * job_count + job] < priority[machine * job_count + selected]) selected = job;
+        }
+        int end = std::max(job_ready[selected], machine_ready[machine]) + instance[selected][job_ptr[selected]].duration;
+        job_ready[selected] = end;
+        machine_ready[machine] = end;
+        ++job_ptr[selected];
+        solution.machine(machine)[scheduled_count[machine]++] = static_cast<IndexT>(selected);
+        makespan = std::max(makespan, end);
+    }
+    solution.makespan = static_cast<TimeT>(makespan);
+    return makespan;
 }
 
 /**
@@ -156,6 +245,89 @@ int JSSPInstance::operationCount() const{
     return op_count;
 }
 
+/**
+ * changes the duration of an operation, e.g. after a delay in the shop
+ * @param job
+ * @param index position of the operation in the job
+ * @param duration new duration
+ * @param update_bound false: lowerBound is outdated until updateLowerBound
+ */
+void JSSPInstance::setDuration(int job, int index, int duration, bool update_bound) {
+    operations[job][index].duration = duration;
+    if (update_bound) updateLowerBound();
+}
+
+/**
+ * lower bound of the makespan: maximum of the job bound (work of a job) and the one machine bound of each machine, see
+ * preemptiveOneMachineBound. Heads are the work of the job before the operation, tails the work after it
+ * @return lower bound
+ */
+int JSSPInstance::calcLowerBound() const {
+    int lower_bound = 0;
+    // (head, duration, tail) of the operations of each machine
+    auto machine_operations = vector<vector<std::tuple<int, int, int>>>(machineCount);
+    for (auto const &job: instance) {
+        int job_work = 0;
+        for (auto const &operation: job) job_work += operation.duration;
+        lower_bound = std::max(lower_bound, job_work);
+        int head = 0;
+        for (auto const &operation: job) {
+            machine_operations[operation.machine].emplace_back(head, operation.duration, job_work - head - operation.duration);
+            head += operation.duration;
+        }
+    }
+
+    for (auto &operations: machine_operations) {
+        lower_bound = std::max(lower_bound, preemptiveOneMachineBound(operations));
+    }
+    return lower_bound;
+}
+
+/**
+ * value of Jackson's preemptive schedule, optimal for the preemptive one machine problem with heads and tails: whenever
+ * an operation is released or finished, the released operation with the longest tail runs. It dominates the machine load
+ * bound (min head + load + min tail)
+ * @param operations (head, duration, tail) of the operations of the machine, sorted by this function
+ * @return max(end + tail) of the preemptive schedule
+ */
+int preemptiveOneMachineBound(vector<std::tuple<int, int, int>> &operations) {
+    std::sort(operations.begin(), operations.end());
+    int bound = 0;
+    // released operations (tail, remaining duration), longest tail first
+    auto released = std::priority_queue<std::pair<int, int>>();
+    long long time = 0;
+    size_t next = 0;
+    while (next < operations.size() || !released.empty()) {
+        if (released.empty()) time = std::max(time, static_cast<long long>(std::get<0>(operations[next])));
+        while (next < operations.size() && std::get<0>(operations[next]) <= time) {
+            released.emplace(std::get<2>(operations[next]), std::get<1>(operations[next]));
+            ++next;
+        }
+        auto [tail, remaining] = released.top();
+        released.pop();
+        long long run = remaining;
+        if (next < operations.size()) run = std::min(run, std::get<0>(operations[next]) - time);
+        time += run;
+        if (run < remaining) {
+            released.emplace(tail, remaining - static_cast<int>(run));
+        } else {
+            bound = std::max(bound, static_cast<int>(time + tail));
+        }
+    }
+    return bound;
+}
+
+/**
+ * makespan at which optimize stops: the lower bound given by the caller (e.g. a known optimum), or the makespan within
+ * the relative target_gap of the lower bound of the instance. With target_gap 0 a run stops when it proved optimality
+ * @param lower_bound given by the caller, 0 if none
+ * @param target_gap relative gap to lowerBound, which is good enough
+ * @return largest makespan which stops the run
+ */
+int JSSPInstance::stopMakespan(int lower_bound, double target_gap) const {
+    return std::max(lower_bound, static_cast<int>(makespanLowerBound * (1 + target_gap)));
+}
+
 /**
  * internal helper function for calcMakespanAndFixSolution. Is called when a solution is identified as infeasible
  * and selects a random ready operation to be scheduled next
@@ -163,9 +335,13 @@ int JSSPInstance::operationCount() const{
  * @param sol_ptr
  * @param job_ptr
  * @param local_rnd
+ * @param memory memory resource for the scratch memory
  */
-void JSSPInstance::recover_solution(vector<vector<int>> &solution, vector<int> &sol_ptr, vector<int> &job_ptr, std::mt19937 &local_rnd) const {
-    vector<int> open_jobs = vector<int>();
+template<typename IndexT, typename TimeT>
+void JSSPInstance::recover_solution(BasicFlatSolution<IndexT, TimeT> &solution, std::pmr::vector<int> &sol_ptr, std::pmr::vector<int> &job_ptr,
+                                    std::mt19937 &local_rnd, std::pmr::memory_resource *memory) const {
+    auto open_jobs = std::pmr::vector<int>(memory);
+    open_jobs.reserve(job_ptr.size());
     for (int i = 0; i < job_ptr.size(); i++) {
         if (job_ptr[i] < instance[i].size()) {
             open_jobs.emplace_back(i);
@@ -174,10 +350,10 @@ void JSSPInstance::recover_solution(vector<vector<int>> &solution, vector<int> &
     std::uniform_int_distribution<std::mt19937::result_type> dist(0, open_jobs.size() - 1);
     int job_no = open_jobs[dist(local_rnd)];
     Operation op = instance[job_no][job_ptr[job_no]];
-    auto new_position = solution[op.machine].begin() + sol_ptr[op.machine];
-    auto old_position = std::find(solution[op.machine].begin(), solution[op.machine].end(), op.job);
-    solution[op.machine].erase(old_position);
-    solution[op.machine].emplace(new_position, op.job);
+    auto new_position = solution.machine(op.machine) + sol_ptr[op.machine];
+    auto old_position = std::find(new_position, solution.machine(op.machine) + solution.stride, op.job);
+    // move the job to new_position, the operations between shift one position back
+    std::rotate(new_position, old_position, old_position + 1);
 }
 
 /**
@@ -256,4 +432,12 @@ Solution JSSPInstance::readSolution(string const &filename) {
     }
     file.close();
     return {solution, makespan};
-}
\ No newline at end of file
+}
+
+#define INSTANTIATE_JSSP_INSTANCE(IndexT, TimeT) \
+    template int JSSPInstance::calcMakespan(BasicFlatSolution<IndexT, TimeT> const &solution) const; \
+    template int JSSPInstance::calcMakespanAndFixSolution(BasicFlatSolution<IndexT, TimeT> &solution, unsigned int _seed, \
+                                                          std::pmr::memory_resource *memory) const; \
+    template int JSSPInstance::decodeActiveSchedule(BasicFlatSolution<IndexT, TimeT> &solution, \
+                                                    std::pmr::memory_resource *memory) const;
+JSSP_LAYOUTS(INSTANTIATE_JSSP_INSTANCE)
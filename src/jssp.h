@@ -6,6 +6,7 @@
 #include <vector>
 #include <tuple>
 #include <random>
+#include <memory_resource>
 
 using std::vector;
 using std::string;
@@ -25,6 +26,46 @@ struct Solution {
     vector<vector<int>> solution;
     int makespan;
 };
+/**
+ * flat solution representation used inside the algorithms: all machine sequences in one contiguous buffer, the
+ * sequence of machine m is sequence[m * stride, (m + 1) * stride). A copy is a single allocation (none if the target
+ * already has the size), a move is free. Convert with BasicFlatSolution(solution) and toSolution() at the API boundary.
+ * IndexT is the type of the job ids, TimeT the type of the makespan, see layout.h
+ */
+template<typename IndexT, typename TimeT>
+struct BasicFlatSolution {
+    vector<IndexT> sequence;
+    // jobs per machine
+    int stride = 0;
+    TimeT makespan = 0;
+
+    BasicFlatSolution() = default;
+    BasicFlatSolution(int machine_count, int job_count): sequence(machine_count * job_count), stride(job_count) {};
+    explicit BasicFlatSolution(vector<vector<int>> const &solution, int makespan = 0):
+            stride(solution.empty() ? 0 : static_cast<int>(solution.front().size())), makespan(static_cast<TimeT>(makespan)) {
+        sequence.reserve(solution.size() * stride);
+        for (auto const &machine: solution) {
+            sequence.insert(sequence.end(), machine.begin(), machine.end());
+        }
+    };
+    explicit BasicFlatSolution(Solution const &solution): BasicFlatSolution(solution.solution, solution.makespan) {};
+
+    inline IndexT *machine(int machine_no) { return sequence.data() + machine_no * stride; };
+    [[nodiscard]] inline IndexT const *machine(int machine_no) const { return sequence.data() + machine_no * stride; };
+    [[nodiscard]] inline int machineCount() const { return stride == 0 ? 0 : static_cast<int>(sequence.size()) / stride; };
+
+    // conversion to the machine sequence representation of the API
+    [[nodiscard]] vector<vector<int>> toNested() const {
+        auto solution = vector<vector<int>>();
+        solution.reserve(machineCount());
+        for (int machine_no = 0; machine_no < machineCount(); machine_no++) {
+            solution.emplace_back(machine(machine_no), machine(machine_no) + stride);
+        }
+        return solution;
+    };
+    [[nodiscard]] Solution toSolution() const { return Solution{toNested(), static_cast<int>(makespan)}; };
+};
+using FlatSolution = BasicFlatSolution<int, int>;
 /**
  * Solution struct containing solution history of the algorithm. Designated for benchmarking
  */
@@ -32,20 +73,48 @@ struct BMResult {
     vector<vector<int>> solution;
     int makespan;
     vector<std::tuple<double,int>> history;
+    // lower bound of the instance, see JSSPInstance::lowerBound, and the relative gap of the makespan to it
+    int lowerBound = 0;
+    double gap = 0;
 };
 
+// one machine bound of (head, duration, tail) operations: value of Jackson's preemptive schedule
+int preemptiveOneMachineBound(vector<std::tuple<int, int, int>> &operations);
+
+// relative gap (makespan - lower_bound) / lower_bound, 0 if there is no lower bound
+inline double relativeGap(int makespan, int lower_bound) {
+    return lower_bound > 0 ? static_cast<double>(makespan - lower_bound) / lower_bound : 0;
+}
+
 class JSSPInstance {
+    // storage of instance and lowerBound, declared first: the constructors derive the dimensions from it
+    vector<vector<Operation>> operations;
+    int makespanLowerBound;
+
 public:
-    const vector<vector<Operation>> instance;
+    // operations of each job, read only: durations change only with setDuration
+    vector<vector<Operation>> const &instance = operations;
     const int jobCount, machineCount;
+    // empty for an instance built in memory
     const string filename;
 
-    explicit JSSPInstance(string &filename): instance(readInstance(filename)), jobCount(std::get<0>(readMetrics(filename))),
-                                                machineCount(std::get<1>(readMetrics(filename))),
-                                                filename(filename), seed(rd()) { rng.seed(seed); };
-    explicit JSSPInstance(string &filename, int seed): instance(readInstance(filename)), jobCount(std::get<0>(readMetrics(filename))),
+    explicit JSSPInstance(string &filename): operations(readInstance(filename)), makespanLowerBound(0),
+                                             jobCount(std::get<0>(readMetrics(filename))),
                                              machineCount(std::get<1>(readMetrics(filename))),
-                                             filename(filename), seed(seed) { rng.seed(seed); };
+                                             filename(filename), seed(rd()) { rng.seed(seed); updateLowerBound(); };
+    explicit JSSPInstance(string &filename, int seed): operations(readInstance(filename)), makespanLowerBound(0),
+                                                       jobCount(std::get<0>(readMetrics(filename))),
+                                                       machineCount(std::get<1>(readMetrics(filename))),
+                                                       filename(filename), seed(seed) { rng.seed(seed); updateLowerBound(); };
+    // instance built in memory, e.g. by a rescheduling session. jobs[j][i].job has to be j, all jobs visit each machine once
+    explicit JSSPInstance(vector<vector<Operation>> jobs): operations(std::move(jobs)), makespanLowerBound(0),
+                                                           jobCount(static_cast<int>(operations.size())),
+                                                           machineCount(operations.empty() ? 0 : static_cast<int>(operations.front().size())),
+                                                           seed(rd()) { rng.seed(seed); updateLowerBound(); };
+    explicit JSSPInstance(vector<vector<Operation>> jobs, int seed): operations(std::move(jobs)), makespanLowerBound(0),
+                                                                     jobCount(static_cast<int>(operations.size())),
+                                                                     machineCount(operations.empty() ? 0 : static_cast<int>(operations.front().size())),
+                                                                     seed(seed) { rng.seed(seed); updateLowerBound(); };
 
     unsigned int getSeed() {
         std::uniform_int_distribution<std::mt19937::result_type> dist(0, INT32_MAX);
@@ -60,12 +129,37 @@ public:
 
     // calculate makespan of a solution of this instance. Will not terminate, if solution is invalid.
     int calcMakespan(vector<vector<int>> const &solution) const;
+    template<typename IndexT, typename TimeT>
+    int calcMakespan(BasicFlatSolution<IndexT, TimeT> const &solution) const;
 
     // number of operations of this instance
     [[nodiscard]] int operationCount() const;
 
+    // lower bound of the makespan: job bound and preemptive one machine bounds, see setDuration
+    [[nodiscard]] int lowerBound() const { return makespanLowerBound; };
+
+    // changes the duration of the index-th operation of a job and updates lowerBound, unless update_bound is false for
+    // a series of changes which ends with updateLowerBound. Engines built on the instance pick it up with their next run.
+    // The only way to change the instance
+    void setDuration(int job, int index, int duration, bool update_bound = true);
+
+    // recomputes lowerBound, see setDuration
+    void updateLowerBound() { makespanLowerBound = calcLowerBound(); };
+
+    // makespan at which a run stops early: the given lower_bound, or when the makespan is within target_gap of lowerBound
+    [[nodiscard]] int stopMakespan(int lower_bound, double target_gap) const;
+
     // repairs any invalid solution based on a random metric and returns makespan of resulting solution
-    int calcMakespanAndFixSolution(vector<vector<int>> &solution, unsigned int _seed=0) const;
+    int calcMakespanAndFixSolution(vector<vector<int>> &solution, unsigned int _seed=0,
+                                   std::pmr::memory_resource *memory = std::pmr::get_default_resource()) const;
+    template<typename IndexT, typename TimeT>
+    int calcMakespanAndFixSolution(BasicFlatSolution<IndexT, TimeT> &solution, unsigned int _seed=0,
+                                   std::pmr::memory_resource *memory = std::pmr::get_default_resource()) const;
+
+    // turns any machine sequence into an active solution (Giffler-Thompson) and returns its makespan
+    template<typename IndexT, typename TimeT>
+    int decodeActiveSchedule(BasicFlatSolution<IndexT, TimeT> &solution,
+                             std::pmr::memory_resource *memory = std::pmr::get_default_resource()) const;
 
 private:
     std::random_device rd;
@@ -78,8 +172,13 @@ private:
     // read first line from file (#jobs, #machines)
     static std::tuple<int,int> readMetrics(string &filename);
 
+    // lower bound of the makespan, see lowerBound
+    [[nodiscard]] int calcLowerBound() const;
+
     // random metric for calcMakespanAndFixSolution
-    void recover_solution(vector<vector<int>> &solution, vector<int> &sol_ptr, vector<int> &job_ptr, std::mt19937 &local_rnd) const;
+    template<typename IndexT, typename TimeT>
+    void recover_solution(BasicFlatSolution<IndexT, TimeT> &solution, std::pmr::vector<int> &sol_ptr, std::pmr::vector<int> &job_ptr,
+                          std::mt19937 &local_rnd, std::pmr::memory_resource *memory) const;
 
     inline static bool contains_op(int m_no, const vector<Operation> & job) {
         for (auto op: job) {if (m_no == op.machine) {return true;}} return false;
@@ -0,0 +1,115 @@
+#ifndef HYBRID_EVO_ALGORITHM_LAYOUT_H
+#define HYBRID_EVO_ALGORITHM_LAYOUT_H
+
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include "jssp.h"
+
+/**
+ * data layout of the algorithms: IndexT is the type of job, machine and operation ids, TimeT the type of durations,
+ * start times and makespans. Narrow types fit more solutions and graph nodes into the cache, see selectLayout.
+ * Jobs and Machines are the instance dimensions if they are known at compile time, 0 if not, see selectShape
+ */
+template<typename IndexT, typename TimeT, int Jobs = 0, int Machines = 0>
+struct Layout {
+    using Index = IndexT;
+    using Time = TimeT;
+    static constexpr int jobs = Jobs;
+    static constexpr int machines = Machines;
+    // marks a missing predecessor / successor
+    static constexpr IndexT nil = std::numeric_limits<IndexT>::max();
+};
+
+/**
+ * narrowest index type for ids in [0, ids), the largest value is reserved for Layout::nil
+ */
+template<long long Ids>
+using IndexFor = std::conditional_t<(Ids < std::numeric_limits<uint8_t>::max()), uint8_t,
+                 std::conditional_t<(Ids < std::numeric_limits<uint16_t>::max()), uint16_t, int32_t>>;
+
+/**
+ * storage of Size elements for layouts with compile time dimensions, part of the owning object. A vector which is
+ * sized at runtime if Size is 0
+ */
+template<typename T, int Size>
+using Buffer = std::conditional_t<Size == 0, vector<T>, std::array<T, Size>>;
+
+/**
+ * instance shapes (jobs x machines) with compile time dimensions, see selectShape
+ */
+template<int Jobs, int Machines>
+struct Shape {
+    static constexpr int jobs = Jobs;
+    static constexpr int machines = Machines;
+};
+using FixedShapes = std::tuple<Shape<10, 10>, Shape<15, 15>, Shape<20, 15>, Shape<20, 20>, Shape<50, 20>>;
+
+/**
+ * all layouts the algorithms are compiled for, X(IndexT, TimeT). Used for the explicit template instantiations
+ */
+#define JSSP_LAYOUTS(X) \
+    X(uint8_t, uint16_t) \
+    X(uint8_t, int32_t) \
+    X(uint16_t, uint16_t) \
+    X(uint16_t, int32_t) \
+    X(int32_t, uint16_t) \
+    X(int32_t, int32_t)
+
+/**
+ * calls f with the narrowest layout which fits the instance: all operation ids (and the nil id) have to fit into
+ * IndexT, the sum of all durations (upper bound of every start time and makespan) into TimeT
+ * @param instance
+ * @param f callable, f(Layout<IndexT, TimeT>{}), all instantiations must return the same type
+ * @param time_horizon latest release time of an operation, added to the sum of the durations
+ * @return return value of f
+ */
+template<typename F>
+auto selectLayout(JSSPInstance const &instance, F &&f, long long time_horizon = 0) {
+    long long duration_sum = time_horizon;
+    for (auto const &job: instance.instance) {
+        for (auto const &op: job) duration_sum += op.duration;
+    }
+    bool narrow_time = duration_sum < std::numeric_limits<uint16_t>::max();
+    long long ids = std::max<long long>({instance.operationCount(), instance.jobCount, instance.machineCount});
+    if (ids < std::numeric_limits<uint8_t>::max()) {
+        return narrow_time ? f(Layout<uint8_t, uint16_t>{}) : f(Layout<uint8_t, int32_t>{});
+    } else if (ids < std::numeric_limits<uint16_t>::max()) {
+        return narrow_time ? f(Layout<uint16_t, uint16_t>{}) : f(Layout<uint16_t, int32_t>{});
+    }
+    return narrow_time ? f(Layout<int32_t, uint16_t>{}) : f(Layout<int32_t, int32_t>{});
+}
+
+
+/**
+ * calls f with the layout L specialised to the dimensions of the instance, if they are one of the FixedShapes
+ * (and the shape has L's index type), with L otherwise
+ * @param instance
+ * @param f callable, f(Layout<IndexT, TimeT, Jobs, Machines>{}), all instantiations must return the same type
+ * @return return value of f
+ */
+template<typename L, typename F>
+auto selectShape(JSSPInstance const &, F &&f, std::tuple<>) {
+    return f(L{});
+}
+
+template<typename L, typename F, typename S, typename... Shapes>
+auto selectShape(JSSPInstance const &instance, F &&f, std::tuple<S, Shapes...>) {
+    if constexpr (std::is_same_v<typename L::Index, IndexFor<S::jobs * S::machines>>) {
+        if (instance.jobCount == S::jobs && instance.machineCount == S::machines) {
+            return f(Layout<typename L::Index, typename L::Time, S::jobs, S::machines>{});
+        }
+    }
+    return selectShape<L>(instance, std::forward<F>(f), std::tuple<Shapes...>{});
+}
+
+template<typename L, typename F>
+auto selectShape(JSSPInstance const &instance, F &&f) {
+    return selectShape<L>(instance, std::forward<F>(f), FixedShapes{});
+}
+
+
+#endif //HYBRID_EVO_ALGORITHM_LAYOUT_H
@@ -0,0 +1,291 @@
+#include "lns.h"
+#include <algorithm>
+#include <thread>
+
+LargeNeighbourhoodSearch::LargeNeighbourhoodSearch(JSSPInstance &instance): instance(instance), jobCount(instance.jobCount),
+        machineCount(instance.machineCount), opCount(instance.jobCount * instance.machineCount), rng(instance.getSeed()),
+        graph(opCount), operationIds(opCount), topologicalOrder(opCount), predecessorCount(opCount) {
+    for (int job = 0; job < jobCount; job++) {
+        for (int index = 0; index < machineCount; index++) {
+            int op = job * machineCount + index;
+            auto const &operation = instance.instance[job][index];
+            graph[op] = Node{index > 0 ? op - 1 : nil, nil, index < machineCount - 1 ? op + 1 : nil, nil,
+                             operation.machine, job, 0, operation.duration, 0};
+            operationIds[job * machineCount + operation.machine] = op;
+        }
+    }
+}
+
+void LargeNeighbourhoodSearch::logMakespan(int value) {
+    std::chrono::duration<double> elapsed_seconds = (std::chrono::system_clock::now() - startTime);
+    makespanHistory.emplace_back(std::tuple{elapsed_seconds.count(), value});
+}
+
+/**
+ * time constrained large neighbourhood search
+ * @param solution feasible starting solution
+ * @param time_limit maximum runtime in seconds, soft limit
+ * @param lower_bound best known solution / lower bound for early stop when found
+ * @return BMResult struct: solution, makespan, history (solution - time log), lower bound and gap
+ */
+BMResult LargeNeighbourhoodSearch::optimize(Solution const &solution, int time_limit, int lower_bound) {
+    startTime = std::chrono::system_clock::now();
+    makespanHistory = vector<std::tuple<double,int>>();
+    lnsStatistics = LNSStatistics();
+    setSolution(solution);
+    logMakespan(makespan);
+
+    int stop_makespan = instance.stopMakespan(lower_bound, 0);
+    std::chrono::duration<double> elapsed_seconds = (std::chrono::system_clock::now() - startTime);
+    while (elapsed_seconds.count() < time_limit && makespan > stop_makespan) {
+        batch();
+        elapsed_seconds = (std::chrono::system_clock::now() - startTime);
+    }
+    return BMResult{sequences, makespan, makespanHistory, instance.lowerBound(), relativeGap(makespan, instance.lowerBound())};
+}
+
+/**
+ * iteration constrained large neighbourhood search
+ * @param solution feasible starting solution
+ * @param max_batches
+ * @return best solution
+ */
+Solution LargeNeighbourhoodSearch::optimize_it(Solution const &solution, long max_batches) {
+    startTime = std::chrono::system_clock::now();
+    lnsStatistics = LNSStatistics();
+    setSolution(solution);
+    for (long i = 0; i < max_batches; i++) batch();
+    return Solution{sequences, makespan};
+}
+
+void LargeNeighbourhoodSearch::setSolution(Solution const &solution) {
+    sequences = solution.solution;
+    for (int machine = 0; machine < machineCount; machine++) link(machine);
+    makespan = evaluate();
+}
+
+void LargeNeighbourhoodSearch::link(int machine) {
+    auto const &jobs = sequences[machine];
+    for (int pos = 0; pos < jobCount; pos++) {
+        auto &node = graph[operationIds[jobs[pos] * machineCount + machine]];
+        node.machPredecessor = pos > 0 ? operationIds[jobs[pos - 1] * machineCount + machine] : nil;
+        node.machSuccessor = pos < jobCount - 1 ? operationIds[jobs[pos + 1] * machineCount + machine] : nil;
+    }
+}
+
+void LargeNeighbourhoodSearch::unlink(int machine) {
+    for (int job = 0; job < jobCount; job++) {
+        auto &node = graph[operationIds[job * machineCount + machine]];
+        node.machPredecessor = nil;
+        node.machSuccessor = nil;
+    }
+}
+
+int LargeNeighbourhoodSearch::evaluate() {
+    return calcHeadsAndTails(graph.data(), opCount, nil, topologicalOrder.data(), predecessorCount.data());
+}
+
+/**
+ * one batch of windows, one per thread: machine windows with probability machineWindowShare, time windows otherwise.
+ * The subproblems are built on the current solution and solved in parallel, the improved ones are applied one after
+ * another, each is kept if the makespan does not get worse
+ */
+void LargeNeighbourhoodSearch::batch() {
+    unsigned int threads = threadCount > 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+    std::uniform_real_distribution<double> dist(0, 1);
+    auto windows = dist(rng) < machineWindowShare ? machineWindows(static_cast<int>(threads))
+                                                  : timeWindows(static_cast<int>(threads));
+
+    auto solve = [this](Window &window) {
+        auto result = BranchAndBound(window.problem).solve(window.start, nodeLimit, 0);
+        // the branch and bound only replaces its start solution by a strictly better one
+        window.improved = result.solution.solution != window.start.solution;
+        window.result = std::move(result.solution);
+    };
+    auto workers = vector<std::thread>();
+    for (size_t i = 1; i < windows.size(); i++) workers.emplace_back(solve, std::ref(windows[i]));
+    if (!windows.empty()) solve(windows[0]);
+    for (auto &worker: workers) worker.join();
+
+    for (auto const &window: windows) {
+        ++lnsStatistics.windows;
+        if (!window.improved) continue;
+        ++lnsStatistics.improved;
+        int previous = makespan;
+        if (apply(window)) {
+            ++lnsStatistics.accepted;
+            if (makespan < previous) logMakespan(makespan);
+        }
+    }
+}
+
+/**
+ * time intervals of width windowOperations / (operations per time unit), at least 5 operations per machine, with a
+ * random offset. Intervals which contain the start of a critical operation (on a longest path) are chosen at random
+ * @param count maximum number of windows
+ * @return windows
+ */
+vector<LargeNeighbourhoodSearch::Window> LargeNeighbourhoodSearch::timeWindows(int count) {
+    // at least about 5 operations per machine, otherwise the window has no blocks to reorder on square instances
+    long long width_operations = std::max(windowOperations, 5 * machineCount);
+    int width = std::max(1, static_cast<int>(static_cast<long long>(makespan) * width_operations / opCount));
+    int offset = std::uniform_int_distribution<int>(0, width - 1)(rng);
+    auto critical_slices = vector<int>();
+    for (auto const &node: graph) {
+        if (node.start + node.duration + node.lenToN != makespan) continue;
+        critical_slices.emplace_back((node.start + width - offset) / width);
+    }
+    std::sort(critical_slices.begin(), critical_slices.end());
+    critical_slices.erase(std::unique(critical_slices.begin(), critical_slices.end()), critical_slices.end());
+    std::shuffle(critical_slices.begin(), critical_slices.end(), rng);
+    if (static_cast<int>(critical_slices.size()) > count) critical_slices.resize(count);
+
+    auto windows = vector<Window>();
+    for (int slice: critical_slices) windows.emplace_back(timeWindow(offset + (slice - 1) * width, offset + slice * width));
+    return windows;
+}
+
+/**
+ * subproblem of the operations which start in [from, to). They are consecutive in each job and in each machine
+ * sequence, and no path leads from an operation after the window back into it, so any order of the window together with
+ * the fixed rest is feasible. Release times are the ends of the fixed job and machine predecessors, delivery times
+ * the tails of the fixed successors, which do not depend on the window
+ * @param from
+ * @param to
+ * @return window
+ */
+LargeNeighbourhoodSearch::Window LargeNeighbourhoodSearch::timeWindow(int from, int to) {
+    auto in_window = [&](int op) { return graph[op].start >= from && graph[op].start < to; };
+    auto end_time = [&](int op) { return op == nil ? 0 : graph[op].start + graph[op].duration; };
+    auto tail_length = [&](int op) { return op == nil ? 0 : graph[op].lenToN + graph[op].duration; };
+    // end of the last fixed operation before the window and tail of the first after it, on each machine
+    auto machine_release = vector<int>(machineCount, 0);
+    auto machine_delivery = vector<int>(machineCount, 0);
+    for (int machine = 0; machine < machineCount; machine++) {
+        for (int job: sequences[machine]) {
+            int op = operationIds[job * machineCount + machine];
+            if (in_window(op)) {
+                machine_release[machine] = end_time(graph[op].machPredecessor);
+                break;
+            }
+        }
+        for (auto it = sequences[machine].rbegin(); it != sequences[machine].rend(); ++it) {
+            int op = operationIds[*it * machineCount + machine];
+            if (in_window(op)) {
+                machine_delivery[machine] = tail_length(graph[op].machSuccessor);
+                break;
+            }
+        }
+    }
+
+    Window window;
+    window.problem.machineCount = machineCount;
+    auto local_job = vector<int>(jobCount, -1);
+    for (int job = 0; job < jobCount; job++) {
+        auto operations = vector<Operation>();
+        auto release = vector<int>();
+        auto delivery = vector<int>();
+        for (int index = 0; index < machineCount; index++) {
+            int op = job * machineCount + index;
+            if (!in_window(op)) continue;
+            auto const &node = graph[op];
+            bool first = operations.empty();
+            bool last = index == machineCount - 1 || !in_window(op + 1);
+            operations.emplace_back(Operation{node.machine, node.duration, static_cast<int>(window.jobMap.size())});
+            release.emplace_back(std::max(machine_release[node.machine], first ? end_time(node.jobPredecessor) : 0));
+            delivery.emplace_back(std::max(machine_delivery[node.machine], last ? tail_length(node.jobSuccessor) : 0));
+        }
+        if (operations.empty()) continue;
+        local_job[job] = static_cast<int>(window.jobMap.size());
+        window.jobMap.emplace_back(job);
+        window.problem.jobs.emplace_back(std::move(operations));
+        window.problem.release.emplace_back(std::move(release));
+        window.problem.delivery.emplace_back(std::move(delivery));
+    }
+    window.start.solution = vector<vector<int>>(machineCount);
+    for (int machine = 0; machine < machineCount; machine++) {
+        for (int job: sequences[machine]) {
+            if (in_window(operationIds[job * machineCount + machine])) window.start.solution[machine].emplace_back(local_job[job]);
+        }
+    }
+    return window;
+}
+
+/**
+ * machines with critical operations, at random
+ * @param count maximum number of windows
+ * @return windows
+ */
+vector<LargeNeighbourhoodSearch::Window> LargeNeighbourhoodSearch::machineWindows(int count) {
+    auto machines = vector<int>();
+    for (auto const &node: graph) {
+        if (node.start + node.duration + node.lenToN == makespan) machines.emplace_back(node.machine);
+    }
+    std::sort(machines.begin(), machines.end());
+    machines.erase(std::unique(machines.begin(), machines.end()), machines.end());
+    std::shuffle(machines.begin(), machines.end(), rng);
+    if (static_cast<int>(machines.size()) > count) machines.resize(count);
+
+    auto windows = vector<Window>();
+    for (int machine: machines) windows.emplace_back(machineWindow(machine));
+    return windows;
+}
+
+/**
+ * subproblem of all operations of a machine: each operation is a job of its own, with its head and tail in the graph
+ * without the machine sequence as release and delivery time. Paths between the operations are not modeled, an order
+ * which contradicts them closes a cycle and is rejected by apply
+ * @param machine
+ * @return window
+ */
+LargeNeighbourhoodSearch::Window LargeNeighbourhoodSearch::machineWindow(int machine) {
+    unlink(machine);
+    evaluate();
+    Window window;
+    window.problem.machineCount = machineCount;
+    for (int job = 0; job < jobCount; job++) {
+        auto const &node = graph[operationIds[job * machineCount + machine]];
+        window.jobMap.emplace_back(job);
+        window.problem.jobs.emplace_back(vector<Operation>{Operation{machine, node.duration, job}});
+        window.problem.release.emplace_back(vector<int>{node.start});
+        window.problem.delivery.emplace_back(vector<int>{node.lenToN});
+    }
+    window.start.solution = vector<vector<int>>(machineCount);
+    window.start.solution[machine] = sequences[machine];
+    link(machine);
+    evaluate();
+    return window;
+}
+
+/**
+ * writes the new order of the window into the positions its operations take in the machine sequences, so the
+ * operations around it stay in place
+ * @param window
+ * @return true if the result was kept: no cycle and the makespan did not get worse
+ */
+bool LargeNeighbourhoodSearch::apply(Window const &window) {
+    auto backup = vector<std::pair<int, vector<int>>>();
+    for (int machine = 0; machine < machineCount; machine++) {
+        auto const &order = window.result.solution[machine];
+        if (order.empty()) continue;
+        backup.emplace_back(machine, sequences[machine]);
+        auto in_window = vector<bool>(jobCount, false);
+        for (int job: window.start.solution[machine]) in_window[window.jobMap[job]] = true;
+        size_t next = 0;
+        for (int &job: sequences[machine]) {
+            if (in_window[job]) job = window.jobMap[order[next++]];
+        }
+        link(machine);
+    }
+    int result = evaluate();
+    if (result >= 0 && result <= makespan) {
+        makespan = result;
+        return true;
+    }
+    for (auto &[machine, sequence]: backup) {
+        sequences[machine] = std::move(sequence);
+        link(machine);
+    }
+    evaluate();
+    return false;
+}
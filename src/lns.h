@@ -0,0 +1,121 @@
+#ifndef HYBRID_EVO_ALGORITHM_LNS_H
+#define HYBRID_EVO_ALGORITHM_LNS_H
+
+#include <chrono>
+#include "jssp.h"
+#include "bnb.h"
+#include "disjunctive_graph.h"
+
+/**
+ * window of operations which is freed and reoptimized, while all other operations stay fixed
+ * time_window: operations which start in a time interval. The fixed operations before and after the window become
+ *              release and delivery times, so the subproblem is exact: its value is the makespan of all paths
+ *              through the window
+ * machine_window: all operations of one machine, with heads and tails of the graph without its sequence, like the
+ *                 reoptimization of the shifting bottleneck
+ */
+enum WindowType {time_window, machine_window};
+
+/**
+ * counters of the large neighbourhood search since construction or the last optimize
+ * windows: solved windows, improved: windows with a better subproblem solution, accepted: windows whose solution
+ * was taken over (makespan not worse)
+ */
+struct LNSStatistics {
+    long windows = 0;
+    long improved = 0;
+    long accepted = 0;
+};
+
+/**
+ * large neighbourhood search for huge instances (100x20 and more): the current solution is improved window by window,
+ * each window is a BranchAndBoundProblem solved by BranchAndBound with a node limit, started from the current order.
+ * Each batch solves up to one window per thread, windows of one batch do not overlap (disjoint time intervals or
+ * machines), so they are solved in parallel on the same solution and applied one after another
+ */
+class LargeNeighbourhoodSearch {
+public:
+    explicit LargeNeighbourhoodSearch(JSSPInstance &instance);
+
+    // improve the solution for time_limit seconds, or until lower_bound (see JSSPInstance::stopMakespan) is reached
+    BMResult optimize(Solution const &solution, int time_limit, int lower_bound = 0);
+
+    // improve the solution for max_batches batches of windows
+    Solution optimize_it(Solution const &solution, long max_batches);
+
+    // OPTIONAL: about window_operations operations per time window, node_limit branch and bound nodes per window,
+    // share of the batches with machine windows
+    void setWindow(int window_operations = 100, long node_limit = 500, double machine_window_share = 0.2) {
+        windowOperations = window_operations; nodeLimit = node_limit; machineWindowShare = machine_window_share; };
+
+    // OPTIONAL: number of threads, 0: all cores
+    void setThreads(unsigned int threads = 0) { threadCount = threads; };
+
+    [[nodiscard]] LNSStatistics const &statistics() const { return lnsStatistics; };
+
+private:
+    using Node = BasicNode<int, int>;
+    static constexpr int nil = -1;
+
+    /**
+     * subproblem of a window: jobs[k] of problem are the operations of original job jobMap[k]
+     * (time_window: consecutive operations of the job, machine_window: a single operation)
+     */
+    struct Window {
+        BranchAndBoundProblem problem;
+        vector<int> jobMap;
+        // current order of the window operations per machine, in subproblem job numbers
+        Solution start;
+        Solution result;
+        bool improved = false;
+    };
+
+    JSSPInstance &instance;
+    int jobCount, machineCount, opCount;
+    std::mt19937 rng;
+    LNSStatistics lnsStatistics;
+    int windowOperations = 100;
+    long nodeLimit = 500;
+    double machineWindowShare = 0.2;
+    unsigned int threadCount = 0;
+
+    // current solution, its disjunctive graph (heads and tails up to date) and its makespan
+    vector<vector<int>> sequences;
+    vector<Node> graph;
+    // operationIds[job * machineCount + machine]: id of the operation of the job on the machine
+    vector<int> operationIds;
+    vector<int> topologicalOrder;
+    vector<uint8_t> predecessorCount;
+    int makespan = 0;
+
+    std::chrono::time_point<std::chrono::system_clock> startTime;
+    vector<std::tuple<double,int>> makespanHistory;
+
+    void setSolution(Solution const &solution);
+
+    // machine arcs of the sequence of a machine
+    void link(int machine);
+    void unlink(int machine);
+
+    // heads and tails of the graph, makespan, -1 if it has a cycle
+    int evaluate();
+
+    // one batch: windows are built on the current solution, solved in parallel and applied one after another
+    void batch();
+
+    // windows in disjoint time intervals which contain critical operations
+    vector<Window> timeWindows(int count);
+    Window timeWindow(int from, int to);
+
+    // windows of distinct machines which contain critical operations
+    vector<Window> machineWindows(int count);
+    Window machineWindow(int machine);
+
+    // writes the window result into the sequences, returns false (and restores them) if the makespan got worse
+    bool apply(Window const &window);
+
+    void logMakespan(int value);
+};
+
+
+#endif //HYBRID_EVO_ALGORITHM_LNS_H
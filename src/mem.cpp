@@ -2,141 +2,309 @@
 #include "mem.h"
 #include <random>
 #include <iostream>
+#include <bitset>
+#include <numeric>
 
 /**
  * logger function for benchmarking
  * @param makespan current best makespan
  */
-void MemeticAlgorithm::logMakespan(int makespan) {
+template<typename L>
+void MemeticEngine<L>::logMakespan(int makespan) {
     std::chrono::duration<double> elapsed_seconds = (std::chrono::system_clock::now() - tStart);
     makespanHistory.emplace_back(std::tuple{elapsed_seconds.count(), makespan});
+    if (improvementCallback) improvementCallback(currentBest.toSolution(), elapsed_seconds.count());
+}
+
+/**
+ * select the layout for the instance, see layout.h
+ */
+MemeticAlgorithm::MemeticAlgorithm(JSSPInstance &instance, int population_size, int tabu_search_iterations, float quality_score_beta):
+        engine(selectLayout(instance, [&](auto layout) -> std::unique_ptr<MemeticBase> {
+            return std::make_unique<MemeticEngine<decltype(layout)>>(instance, population_size, tabu_search_iterations, quality_score_beta);
+        })) {}
+
+/**
+ * reset currentBest to an empty solution with the largest makespan, before a new run
+ */
+template<typename L>
+void MemeticEngine<L>::resetBest() {
+    currentBest = FlatSolutionT();
+    currentBest.makespan = std::numeric_limits<TimeT>::max();
+}
+
+/**
+ * result of a run, the makespan is INT32_MAX if the run stopped before the first solution was optimized
+ * @return struct: solution, value, log, lower bound and gap
+ */
+template<typename L>
+BMResult MemeticEngine<L>::bestResult() const {
+    int makespan = currentBest.sequence.empty() ? INT32_MAX : currentBest.makespan;
+    return BMResult{currentBest.toNested(), makespan, makespanHistory, instance.lowerBound(),
+                    relativeGap(makespan, instance.lowerBound())};
 }
 
 /**
  * main function, initialize with object with an JSSPInstance, start optimization/benchmark with this function
  * @param time_limit maximum runtime - soft limit
- * @param lower_bound or lb for an early stop
+ * @param lower_bound or lb for an early stop, see also setTargetGap
  * @return struct: solution, value, log
  */
-BMResult MemeticAlgorithm::optimize(int time_limit, int lower_bound) {
-    tStart = std::chrono::system_clock::now();
-    makespanHistory = vector<std::tuple<double,int>>();
-    population = vector<Solution>();
-
-    currentBest = Solution{vector<vector<int>>(), INT32_MAX};
-    initializeRandPopulation();
-    for (auto &p: population) {
-        auto elapsed_seconds = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now() - tStart);
-        if (elapsed_seconds.count() > time_limit || lower_bound == currentBest.makespan) {
-            return BMResult{currentBest.solution, currentBest.makespan, makespanHistory};
-        }
-        p = ts_algo.optimize_it(p, tabuSearchIterations);
-        if (p.makespan < currentBest.makespan) {
-            currentBest = p;
-            logMakespan(currentBest.makespan);
-        }
-    }
-    optimizeLoop(time_limit, lower_bound);
-    return BMResult{currentBest.solution, currentBest.makespan, makespanHistory};
+template<typename L>
+BMResult MemeticEngine<L>::optimize(int time_limit, int lower_bound) {
+    start({}, lower_bound);
+    // the time limit includes the random solutions of start
+    std::chrono::duration<double> elapsed_seconds = std::chrono::system_clock::now() - tStart;
+    if (elapsed_seconds.count() < time_limit) step(0, time_limit - elapsed_seconds.count());
+    return finish();
 }
 
 /**
  * secondary main function, initialize with object with an JSSPInstance, start optimization/benchmark with this function.
  * use if you want to start with a set start solutions, else use MemeticAlgorithm::optimize
  * @param time_limit maximum runtime - soft limit
- * @param lower_bound or lb for an early stop
+ * @param lower_bound or lb for an early stop, see also setTargetGap
  * @param start_solutions vector of feasible start solutions
  * @return struct: solution, value, log
  */
-BMResult MemeticAlgorithm::optimizePopulation(int time_limit, vector<Solution> &start_solutions, int lower_bound) {
+template<typename L>
+BMResult MemeticEngine<L>::optimizePopulation(int time_limit, vector<Solution> &start_solutions, int lower_bound) {
+    start(start_solutions, lower_bound);
+    start_solutions.clear();
+    // the time limit includes the random solutions of start
+    std::chrono::duration<double> elapsed_seconds = std::chrono::system_clock::now() - tStart;
+    if (elapsed_seconds.count() < time_limit) step(0, time_limit - elapsed_seconds.count());
+    return finish();
+}
+
+/**
+ * starts a resumable run, see step. The population is filled up with random solutions, they are optimized by the
+ * first steps
+ * @param start_solutions feasible start solutions, may be empty
+ * @param lower_bound or lb for an early stop, see also setTargetGap
+ */
+template<typename L>
+void MemeticEngine<L>::start(vector<Solution> const &start_solutions, int lower_bound) {
     tStart = std::chrono::system_clock::now();
     makespanHistory = vector<std::tuple<double,int>>();
-    population = std::move(start_solutions);
+    // one entry per new best makespan, reserved so that the generations do not allocate
+    makespanHistory.reserve(1024);
+    populationCount = 0;
+    for (auto const &solution: start_solutions) {
+        appendMember() = FlatSolutionT(solution);
+    }
 
-    currentBest = Solution{vector<vector<int>>(), INT32_MAX};
+    resetBest();
+    improvedCache.reset(improvedCacheCapacity, instance.operationCount());
+    archive.clear();
+    improvementIterations = tabuSearchIterations / 2.0;
+    runStopMakespan = instance.stopMakespan(lower_bound, targetGap);
     initializeRandPopulation();
-    for (auto &p: population) {
-        auto elapsed_seconds = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now() - tStart);
-        if (elapsed_seconds.count() > time_limit || lower_bound == currentBest.makespan) {
-            return BMResult{currentBest.solution, currentBest.makespan, makespanHistory};
-        }
-        p = ts_algo.optimize_it(p, tabuSearchIterations);
-        if (p.makespan < currentBest.makespan) {
-            currentBest = p;
-            logMakespan(currentBest.makespan);
+    optimizedMembers = 0;
+    generation = 0;
+}
+
+/**
+ * continues the run of start: the tabu search of the population members, then the generations of the main loop
+ * @param max_iterations member optimizations and generations of this step, 0: no limit
+ * @param seconds runtime of this step, soft limit, 0: no limit
+ * @return false if the run reached its lower bound and can not improve anymore
+ */
+template<typename L>
+bool MemeticEngine<L>::step(long max_iterations, double seconds) {
+    auto step_start = std::chrono::system_clock::now();
+    std::chrono::duration<double> elapsed_seconds{0};
+    for (long iteration = 0; (max_iterations == 0 || iteration < max_iterations) &&
+                             (seconds == 0 || elapsed_seconds.count() < seconds) &&
+                             currentBest.makespan > runStopMakespan; iteration++) {
+        if (optimizedMembers < static_cast<size_t>(populationCount)) {
+            optimizeMember();
+            if (optimizedMembers == static_cast<size_t>(populationCount)) startGenerations();
+        } else {
+            runGeneration();
         }
+        if (seconds > 0) elapsed_seconds = std::chrono::system_clock::now() - step_start;
+    }
+    return currentBest.makespan > runStopMakespan;
+}
+
+/**
+ * initialization of a run: tabu search on the next solution of the population
+ */
+template<typename L>
+void MemeticEngine<L>::optimizeMember() {
+    auto &p = population[optimizedMembers++];
+    p = ts_algo->optimize_it(p, tabuSearchIterations, 0);
+    archive.insert(p);
+    if (p.makespan < currentBest.makespan) {
+        currentBest = p;
+        logMakespan(currentBest.makespan);
     }
-    optimizeLoop(time_limit, lower_bound);
-    return BMResult{currentBest.solution, currentBest.makespan, makespanHistory};
+}
 
+/**
+ * after the initialization: seeds the selection of the parents and rates the similarity of the population
+ */
+template<typename L>
+void MemeticEngine<L>::startGenerations() {
+    rng = std::mt19937(instance.getSeed());
+    resetSimilarityMatrix();
+    appendSimilarityRows();
 }
 
 /**
- * internal function, the main loop of the algorithm
+ * one generation of the main loop
  * function manipulates population and currentBest
- * @param time_limit passed by optimize
- * @param known_optimum passed by optimize
- * @param ts_algo initialized tabu search instance
  */
-void MemeticAlgorithm::optimizeLoop(int time_limit, int known_optimum) {
-    rng = std::mt19937(instance.getSeed());
+template<typename L>
+void MemeticEngine<L>::runGeneration() {
     std::uniform_int_distribution<std::mt19937::result_type> dist(0,populationSize - 1);
+    scratchArena.reset();
+    auto p1 = dist(rng);
+    auto p2 = dist(rng);
+    while (p1 == p2) p2 = dist(rng);
 
-    std::chrono::duration<double> elapsed_seconds = (std::chrono::system_clock::now() - tStart);
-    // main loop
-    while (elapsed_seconds.count() < time_limit && known_optimum != currentBest.makespan) {
-        auto p1 = dist(rng);
-        auto p2 = dist(rng);
-        while (p1 == p2) p2 = dist(rng);
+    recombinationOperator(population[p1], population[p2], offspring1, offspring2);
 
-        auto children = recombinationOperator(population[p1], population[p2]);
-
-        auto child1 = ts_algo.optimize_it(std::get<0>(children), tabuSearchIterations);
-        auto child2 = ts_algo.optimize_it(std::get<1>(children), tabuSearchIterations);
-        if (child1.makespan < currentBest.makespan) {
-            currentBest = child1;
-            logMakespan(currentBest.makespan);
-        }
-        if (child2.makespan < currentBest.makespan) {
-            currentBest = child2;
+    for (auto const *offspring: {&offspring1, &offspring2}) {
+        auto const *child = improveChild(*offspring, population[p1], population[p2]);
+        if (child != nullptr && child->makespan < currentBest.makespan) {
+            currentBest = *child;
             logMakespan(currentBest.makespan);
         }
-        population.emplace_back(child1);
-        population.emplace_back(child2);
-        updatePopulation();
+    }
+    updatePopulation();
 
-        elapsed_seconds = (std::chrono::system_clock::now() - tStart);
+    if (migrationInterval > 0 && ++generation % migrationInterval == 0) {
+        migrate();
     }
 }
 
 /**
- * called by optimize, before starting main loop
+ * called by optimize, before starting main loop. fills the population with random solutions, generated in parallel
+ * on initializationThreads threads
  */
-void MemeticAlgorithm::initializeRandPopulation() {
-    while (population.size() < populationSize) {
-        auto solution = Heuristics::random(instance);
-        population.emplace_back(Solution{solution, instance.calcMakespan(solution)});
+template<typename L>
+void MemeticEngine<L>::initializeRandPopulation() {
+    int missing = populationSize - populationCount;
+    if (missing <= 0) return;
+    for (auto const &solution: Heuristics::randomPopulation(instance, missing, initializationThreads)) {
+        appendMember() = FlatSolutionT(solution);
     }
 }
 
+/**
+ * appends a slot to the population. Slots behind the population keep the storage of evicted solutions, so a solution
+ * of the same size is copied into it without allocation
+ * @return the new last solution of the population
+ */
+template<typename L>
+typename MemeticEngine<L>::FlatSolutionT &MemeticEngine<L>::appendMember() {
+    if (populationCount == static_cast<int>(population.size())) population.emplace_back();
+    return population[populationCount++];
+}
+
+/**
+ * fingerprint of the machine sequences, splitmix64 finalizer over the sequence. Used as key of the improvedCache
+ * @param solution
+ * @return 64 bit fingerprint
+ */
+template<typename L>
+uint64_t MemeticEngine<L>::fingerprint(FlatSolutionT const &solution) {
+    uint64_t hash = 0;
+    for (auto job: solution.sequence) {
+        hash = (hash ^ static_cast<uint64_t>(job)) * 0x9e3779b97f4a7c15;
+        hash ^= hash >> 29;
+    }
+    hash ^= hash >> 32;
+    hash *= 0xbf58476d1ce4e5b9;
+    return hash ^ (hash >> 31);
+}
+
+/**
+ * takes a child of the recombination operator into the population. Late in a run the population converges and the
+ * children are often equal or almost equal to a parent or another solution of the population, the tabu search
+ * would mostly return to the known local optimum:
+ * (1) children closer than nearDuplicateDistance to a solution of the population are dropped
+ * (2) children which were optimized before take the local optimum from the improvedCache
+ * (3) all others are optimized with the tabu search and cached
+ * @param child offspring of the recombination operator
+ * @return the new solution of the population, nullptr if the child was dropped
+ */
+template<typename L>
+typename MemeticEngine<L>::FlatSolutionT const *MemeticEngine<L>::improveChild(FlatSolutionT const &child, FlatSolutionT const &parent_1, FlatSolutionT const &parent_2) {
+    bool near_duplicate = std::any_of(population.begin(), population.begin() + populationCount, [&](FlatSolutionT const &p) {
+        return sequenceDistance(child, p) < nearDuplicateDistance; });
+    if (near_duplicate) return nullptr;
+    int parent_distance = std::min(sequenceDistance(child, parent_1), sequenceDistance(child, parent_2));
+    uint64_t key = fingerprint(child);
+    // the parents stay valid, the population has room for both children (see resetSimilarityMatrix)
+    auto &member = appendMember();
+    if (!improvedCache.find(key, child, member)) {
+        member = optimizeChild(child, parent_distance);
+        improvedCache.insert(key, child, member);
+    }
+    archive.insert(member);
+    return &member;
+}
+
+/**
+ * tabu search on a child. With the adaptive budget the search stops after twice the moving average of the iteration
+ * of the last improvement without improvement, and children close to one of their parents (in its basin of
+ * attraction) get fewer iterations: from a quarter of tabuSearchIterations for a copy to all of them for a quarter of
+ * the positions changed
+ * @param child
+ * @param parent_distance sequence distance to the closer parent
+ * @return the tabu search result, valid until the next tabu search call
+ */
+template<typename L>
+typename MemeticEngine<L>::FlatSolutionT const &MemeticEngine<L>::optimizeChild(FlatSolutionT const &child, int parent_distance) {
+    if (!adaptiveBudget) return ts_algo->optimize_it(child, tabuSearchIterations, 0);
+    double spread = std::min(1.0, 4.0 * parent_distance / static_cast<double>(child.sequence.size()));
+    auto max_iterations = static_cast<long>(tabuSearchIterations * (0.25 + 0.75 * spread));
+    auto max_stagnation = std::max(static_cast<long>(2 * improvementIterations), static_cast<long>(tabuSearchIterations / 12));
+    auto const &result = ts_algo->optimize_it(child, max_iterations, max_stagnation);
+    improvementIterations += 0.1 * (static_cast<double>(ts_algo->lastImprovement()) - improvementIterations);
+    return result;
+}
+
 /**
  * recombination operator: picks two parent solutions from population, finds longest common sequence (lcs) for each
- * machine and calls crossover on each machine pair to create two new child machines
+ * machine and calls crossover on each machine pair to create two new child machines, which are made feasible by the
+ * childRepair.
+ * with path_relinking the children are the relinking results from each parent towards the other instead.
+ * the children are written into the given solutions, so their storage is reused between generations. Scratch memory
+ * is taken from the scratchArena
  * @param parent_1
  * @param parent_2
- * @return two new child solutions, with both parents features
+ * @param child_1 new child solution, with both parents features
+ * @param child_2 new child solution, with both parents features
  */
-std::tuple<Solution, Solution> MemeticAlgorithm::recombinationOperator(Solution const &parent_1, Solution const &parent_2) {
-    auto child_1_solution = vector<vector<int>>();
-    auto child_2_solution = vector<vector<int>>();
+template<typename L>
+void MemeticEngine<L>::recombinationOperator(FlatSolutionT const &parent_1, FlatSolutionT const &parent_2, FlatSolutionT &child_1, FlatSolutionT &child_2) {
+    child_1.sequence.resize(parent_1.sequence.size());
+    child_1.stride = parent_1.stride;
+    child_2.sequence.resize(parent_1.sequence.size());
+    child_2.stride = parent_1.stride;
+    if (recombinationOperatorType == path_relinking) {
+        ts_algo->relink(parent_1, parent_2, child_1);
+        ts_algo->relink(parent_2, parent_1, child_2);
+        return;
+    }
     for (int machine = 0; machine < instance.machineCount; machine++) {
-        auto lcs = findLongestCommonSequence(parent_1.solution[machine], parent_2.solution[machine]);
-        child_1_solution.emplace_back(crossover(parent_1.solution[machine], parent_2.solution[machine], lcs));
-        child_2_solution.emplace_back(crossover(parent_2.solution[machine], parent_1.solution[machine], lcs));
+        auto marker = scratchArena.mark();
+        auto lcs = findLongestCommonSequence(parent_1.machine(machine), parent_2.machine(machine), parent_1.stride, &scratchArena);
+        crossover(parent_1.machine(machine), parent_2.machine(machine), parent_1.stride, lcs, child_1.machine(machine), &scratchArena);
+        crossover(parent_2.machine(machine), parent_1.machine(machine), parent_1.stride, lcs, child_2.machine(machine), &scratchArena);
+        scratchArena.rewind(marker);
+    }
+    if (childRepair == active_decoding) {
+        instance.decodeActiveSchedule(child_1, &scratchArena);
+        instance.decodeActiveSchedule(child_2, &scratchArena);
+    } else {
+        instance.calcMakespanAndFixSolution(child_1, rng(), &scratchArena);
+        instance.calcMakespanAndFixSolution(child_2, rng(), &scratchArena);
     }
-    auto makespan_1 = instance.calcMakespanAndFixSolution(child_1_solution, rng());
-    auto makespan_2 = instance.calcMakespanAndFixSolution(child_2_solution, rng());
-    return {Solution{child_1_solution, makespan_1}, Solution{child_2_solution, makespan_2}};
 }
 
 /**
@@ -148,14 +316,20 @@ std::tuple<Solution, Solution> MemeticAlgorithm::recombinationOperator(Solution
  * c1 : [1 3 2 4 5 6], c2 : [2 3 4 1 5 6] (2)
  * @param machine_parent_1
  * @param machine_parent_2
+ * @param job_count length of the machine sequences
  * @param lcs longest common sequence of both parents
- * @return two child machine sequences as described above
+ * @param child_sequence output: child machine sequence as described above, job_count jobs
+ * @param memory memory resource for the scratch memory
  */
-vector<int> MemeticAlgorithm::crossover(vector<int> const &machine_parent_1, vector<int> const &machine_parent_2, vector<int> const &lcs) {
-    vector<int> p2_without_lcs = vector<int>();
-    int i_lcs = 0;
-    for (int job : machine_parent_2) {
-        if (job != lcs[i_lcs] || i_lcs >= lcs.size()) {
+template<typename L>
+void MemeticEngine<L>::crossover(IndexT const *machine_parent_1, IndexT const *machine_parent_2, int job_count, std::pmr::vector<IndexT> const &lcs,
+                                 IndexT *child_sequence, std::pmr::memory_resource *memory) {
+    auto p2_without_lcs = std::pmr::vector<IndexT>(memory);
+    p2_without_lcs.reserve(job_count);
+    size_t i_lcs = 0;
+    for (int i = 0; i < job_count; i++) {
+        int job = machine_parent_2[i];
+        if (i_lcs >= lcs.size() || job != lcs[i_lcs]) {
             p2_without_lcs.emplace_back(job);
         } else {
           ++i_lcs;
@@ -163,115 +337,328 @@ vector<int> MemeticAlgorithm::crossover(vector<int> const &machine_parent_1, vec
     }
     i_lcs = 0;
     int i_p2 = 0;
-    vector<int> child_sequence = vector<int>();
-    for (int job : machine_parent_1) {
-        if (job == lcs[i_lcs] && i_lcs < lcs.size()) {
-            child_sequence.emplace_back(job);
+    for (int i = 0; i < job_count; i++) {
+        int job = machine_parent_1[i];
+        if (i_lcs < lcs.size() && job == lcs[i_lcs]) {
+            child_sequence[i] = job;
             ++i_lcs;
         } else  {
-            child_sequence.emplace_back(p2_without_lcs[i_p2]);
+            child_sequence[i] = p2_without_lcs[i_p2];
             ++i_p2;
         }
     }
-    return child_sequence;
 }
 
 /**
- * finds the longest common sequence (lcs) of two given (parent) machines with dynamic programming (-> dp_matrix)
+ * finds the longest common sequence (lcs) of two given (parent) machines. Both machines are permutations of the job
+ * numbers 0..n-1, so the lcs is the longest increasing subsequence of the positions in machine_2 of the jobs of
+ * machine_1, found by patience sorting in O(n log n) time and O(n) memory.
  * Example:
  * m1 : [1 2 3 4 5 6], m2 : [5 1 6 2 3 4]
+ * positions of m1 in m2 : [1 3 4 5 0 2] -> longest increasing : [1 3 4 5]
  * lcs : [1 2 3 4]
  * @param machine_1
  * @param machine_2
+ * @param job_count length of the machine sequences
+ * @param memory memory resource for the result and the scratch memory
  * @return the longest common sequence of the two machines
  */
-vector<int> MemeticAlgorithm::findLongestCommonSequence(const vector<int> &machine_1, const vector<int> &machine_2) {
-    auto len = machine_1.size() + 1;
-    auto dp_matrix = vector<vector<int>>();
-    dp_matrix.emplace_back(vector<int>(len));
-    for (auto i = 1; i < len; i++) {
-        dp_matrix.emplace_back(vector<int>(machine_1.size() + 1));
-        for (int ii = 1; ii < len; ii++) {
-            if (machine_1[i - 1] == machine_2[ii - 1]) {
-                dp_matrix[i][ii] = dp_matrix[i - 1][ii - 1] + 1;
-            } else {
-                dp_matrix[i][ii] = std::max(dp_matrix[i - 1][ii], dp_matrix[i][ii - 1]);
-            }
-        }
+template<typename L>
+std::pmr::vector<typename MemeticEngine<L>::IndexT> MemeticEngine<L>::findLongestCommonSequence(IndexT const *machine_1, IndexT const *machine_2, int job_count,
+                                                                                                std::pmr::memory_resource *memory) {
+    auto position_2 = std::pmr::vector<int>(job_count, memory);
+    for (int i = 0; i < job_count; i++) {
+        position_2[machine_2[i]] = i;
     }
-    auto lcs = vector<int>();
-    for (auto i = len - 1; i >= 0;) {
-        for (auto ii = len - 1; ii >= 0;) {
-            if (dp_matrix[i][ii] == 0) {
-                std::reverse(lcs.begin(), lcs.end());
-                return lcs;
-            } else if (dp_matrix[i][ii] > dp_matrix[i - 1][ii] && dp_matrix[i][ii] > dp_matrix[i][ii - 1]) {
-                lcs.emplace_back(machine_1[i - 1]);
-                --i;
-                --ii;
-            } else if (dp_matrix[i - 1][ii] > dp_matrix[i][ii - 1]) {
-                --i;
-            } else {
-                --ii;
-            }
+    // tails[k]: index in machine_1 of the smallest tail of all increasing subsequences of length k + 1
+    auto tails = std::pmr::vector<int>(memory);
+    tails.reserve(job_count);
+    auto predecessor = std::pmr::vector<int>(job_count, memory);
+    for (int i = 0; i < job_count; i++) {
+        int position = position_2[machine_1[i]];
+        auto k = static_cast<size_t>(std::lower_bound(tails.begin(), tails.end(), position,
+                                  [&](int tail, int value) { return position_2[machine_1[tail]] < value; }) - tails.begin());
+        predecessor[i] = k > 0 ? tails[k - 1] : -1;
+        if (k == tails.size()) {
+            tails.emplace_back(i);
+        } else {
+            tails[k] = i;
         }
     }
-    std::reverse(lcs.begin(), lcs.end());
+    auto lcs = std::pmr::vector<IndexT>(tails.size(), memory);
+    for (int i = tails.empty() ? -1 : tails.back(), k = static_cast<int>(tails.size()) - 1; i >= 0; i = predecessor[i], k--) {
+        lcs[k] = machine_1[i];
+    }
     return lcs;
 }
 
+/**
+ * length of the longest common sequence of two machines, see MemeticAlgorithm::findLongestCommonSequence.
+ * used for the similarity rating, where the sequence itself is not needed
+ * @param machine_1
+ * @param machine_2
+ * @param job_count length of the machine sequences
+ * @param memory memory resource for the scratch memory
+ * @return length of the longest common sequence
+ */
+template<typename L>
+int MemeticEngine<L>::lcsLength(IndexT const *machine_1, IndexT const *machine_2, int job_count, std::pmr::memory_resource *memory) {
+    auto position_2 = std::pmr::vector<int>(job_count, memory);
+    for (int i = 0; i < job_count; i++) {
+        position_2[machine_2[i]] = i;
+    }
+    // tails[k]: smallest position in machine_2 ending an increasing subsequence of length k + 1
+    auto tails = std::pmr::vector<int>(memory);
+    tails.reserve(job_count);
+    for (int i = 0; i < job_count; i++) {
+        int job = machine_1[i];
+        auto it = std::lower_bound(tails.begin(), tails.end(), position_2[job]);
+        if (it == tails.end()) {
+            tails.emplace_back(position_2[job]);
+        } else {
+            *it = position_2[job];
+        }
+    }
+    return static_cast<int>(tails.size());
+}
+
 /**
  * rates the solution at given index by similarity to all other solutions of the population
- * similarity: maximum in the population of the sum over the length of all longest common sequences (lcs) for each
- * same machine pair
+ * similarity degree: maximum similarity to another solution of the population, see MemeticAlgorithm::calcSimilarity.
+ * Values are taken from the similarityMatrix, which has to be up to date
  * @param solution_index index of the solution in the population
  * @return similarity degree
  */
-int MemeticAlgorithm::calcSimilarityDegree(int solution_index) {
-    auto similarity_degree = vector<int>();
-    for (int i = 0; i < population.size(); i++) {
+template<typename L>
+int MemeticEngine<L>::calcSimilarityDegree(int solution_index) {
+    int similarity_degree = 0;
+    for (int i = 0; i < populationCount; i++) {
         if (i == solution_index) continue;
-        int sum = 0;
-        for (int machine = 0; machine < population[i].solution.size(); machine++) {
-            auto lcs = findLongestCommonSequence(population[solution_index].solution[machine],
-                                                 population[i].solution[machine]);
-            sum += lcs.size();
+        similarity_degree = std::max(similarity_degree, similarity(solution_index, i));
+    }
+    return similarity_degree;
+}
+
+/**
+ * similarity of two solutions of the population according to the metric of the run (runDiversityMetric)
+ * lcs_similarity: sum over the length of the longest common sequences (lcs) of each same machine pair
+ * precedence_distance: number of job pairs which are ordered equally on the same machine in both solutions
+ * @param solution_index_1
+ * @param solution_index_2
+ * @return similarity
+ */
+template<typename L>
+int MemeticEngine<L>::calcSimilarity(int solution_index_1, int solution_index_2) {
+    if (runDiversityMetric == precedence_distance) {
+        int pair_count = instance.machineCount * instance.jobCount * (instance.jobCount - 1) / 2;
+        return pair_count - precedenceDistance(precedenceBits[solution_index_1], precedenceBits[solution_index_2]);
+    }
+    auto const &solution_1 = population[solution_index_1];
+    auto const &solution_2 = population[solution_index_2];
+    int sum = 0;
+    auto marker = scratchArena.mark();
+    for (int machine = 0; machine < instance.machineCount; machine++) {
+        sum += lcsLength(solution_1.machine(machine), solution_2.machine(machine), solution_1.stride, &scratchArena);
+        scratchArena.rewind(marker);
+    }
+    return sum;
+}
+
+/**
+ * packs the orderings of all job pairs (a, b), a < b, of each machine into a bit vector. The bit of a pair is set, if
+ * a is processed before b. Pairs are numbered machine by machine, in lexicographic order.
+ * @param solution
+ * @param bits output: bit vector of m * n * (n - 1) / 2 bits, its storage is reused
+ */
+template<typename L>
+void MemeticEngine<L>::calcPrecedenceBits(FlatSolutionT const &solution, vector<uint64_t> &bits) {
+    long long pair_count = static_cast<long long>(instance.machineCount) * instance.jobCount * (instance.jobCount - 1) / 2;
+    bits.assign((pair_count + 63) / 64, 0);
+    auto marker = scratchArena.mark();
+    auto position = std::pmr::vector<int>(instance.jobCount, &scratchArena);
+    long long bit = 0;
+    for (int machine = 0; machine < instance.machineCount; machine++) {
+        for (int i = 0; i < solution.stride; i++) {
+            position[solution.machine(machine)[i]] = i;
+        }
+        for (int a = 0; a < instance.jobCount; a++) {
+            for (int b = a + 1; b < instance.jobCount; b++, bit++) {
+                if (position[a] < position[b]) bits[bit / 64] |= uint64_t(1) << (bit % 64);
+            }
         }
-        similarity_degree.emplace_back(sum);
     }
-    return *std::max_element(similarity_degree.begin(), similarity_degree.end());
+    scratchArena.rewind(marker);
 }
 
 /**
- * calcs quality and similarity score for each solution and removes the worst two.
- * population size at start of the method is populationSize + 2, at the end populationSize.
- * you could save some time here by minimizing the score calculation overhead with dp but it is a minimal factor
- * compared to the tabu search each iteration.
+ * disjunctive pair distance of two solutions: number of job pairs ordered differently on the same machine
+ * @param bits_1 see MemeticAlgorithm::calcPrecedenceBits
+ * @param bits_2
+ * @return distance
  */
-void MemeticAlgorithm::updatePopulation() {
-    vector<std::tuple<float,int>> quality_list = vector<std::tuple<float,int>>();
-    vector<int> similarity_degrees = vector<int>();
-    for (int i = 0; i < population.size(); i++) {
+template<typename L>
+int MemeticEngine<L>::precedenceDistance(vector<uint64_t> const &bits_1, vector<uint64_t> const &bits_2) {
+    int distance = 0;
+    for (size_t i = 0; i < bits_1.size(); i++) {
+        distance += static_cast<int>(std::bitset<64>(bits_1[i] ^ bits_2[i]).count());
+    }
+    return distance;
+}
+
+/**
+ * allocates the similarityMatrix for the current population plus two children and marks all rows as outdated.
+ * called at the start of each run, afterwards the matrix is updated incrementally without allocations
+ */
+template<typename L>
+void MemeticEngine<L>::resetSimilarityMatrix() {
+    similarityStride = populationCount + 2;
+    similarityMatrix.assign(similarityStride * similarityStride, 0);
+    similarityRows = 0;
+    // a metric changed during a run (e.g. between step calls) takes effect with the next matrix
+    runDiversityMetric = diversityMetric;
+    if (runDiversityMetric == precedence_distance) precedenceBits.resize(similarityStride);
+    population.reserve(similarityStride);
+}
+
+/**
+ * calculates the similarity rows of all solutions which were appended to the population since the last call, so only
+ * the new solutions are compared to the population: O(new * populationSize) similarity calls instead of
+ * O(populationSize^2)
+ */
+template<typename L>
+void MemeticEngine<L>::appendSimilarityRows() {
+    for (int i = similarityRows; i < populationCount; i++) {
+        if (runDiversityMetric == precedence_distance) calcPrecedenceBits(population[i], precedenceBits[i]);
+        for (int j = 0; j < i; j++) {
+            int value = calcSimilarity(i, j);
+            similarity(i, j) = value;
+            similarity(j, i) = value;
+        }
+    }
+    similarityRows = populationCount;
+}
+
+/**
+ * recalculates row and column of a solution, which was replaced in the population
+ * @param solution_index
+ */
+template<typename L>
+void MemeticEngine<L>::updateSimilarityRow(int solution_index) {
+    if (runDiversityMetric == precedence_distance) calcPrecedenceBits(population[solution_index], precedenceBits[solution_index]);
+    for (int j = 0; j < similarityRows; j++) {
+        if (j == solution_index) continue;
+        int value = calcSimilarity(solution_index, j);
+        similarity(solution_index, j) = value;
+        similarity(j, solution_index) = value;
+    }
+}
+
+/**
+ * removes row and column of a solution, call together with removing the solution from the population.
+ * the last row and column are moved to the index of the removed solution, like the last solution of the population
+ * @param solution_index
+ */
+template<typename L>
+void MemeticEngine<L>::eraseSimilarityRow(int solution_index) {
+    int last = similarityRows - 1;
+    if (solution_index != last) {
+        for (int j = 0; j < similarityRows; j++) {
+            similarity(solution_index, j) = similarity(last, j);
+            similarity(j, solution_index) = similarity(j, last);
+        }
+        similarity(solution_index, solution_index) = 0;
+        if (runDiversityMetric == precedence_distance) std::swap(precedenceBits[solution_index], precedenceBits[last]);
+    }
+    --similarityRows;
+}
+
+/**
+ * calcs quality and similarity score for each solution and removes the worst, one for each accepted child.
+ * population size at start of the method is populationSize + 0..2, at the end populationSize.
+ * similarities are only calculated for the two new solutions, see MemeticAlgorithm::appendSimilarityRows.
+ * a removed solution is replaced by the last solution of the population
+ */
+template<typename L>
+void MemeticEngine<L>::updatePopulation() {
+    appendSimilarityRows();
+    auto quality_list = std::pmr::vector<std::tuple<float,int>>(&scratchArena);
+    auto similarity_degrees = std::pmr::vector<int>(&scratchArena);
+    quality_list.reserve(populationCount);
+    similarity_degrees.reserve(populationCount);
+    for (int i = 0; i < populationCount; i++) {
         similarity_degrees.emplace_back(calcSimilarityDegree(i));
     }
-    int max_makespan = std::max_element(population.begin(), population.end(), byMakespanDecs)->makespan;
-    int min_makespan = std::min_element(population.begin(), population.end(), byMakespanDecs)->makespan;
+    auto population_end = population.begin() + populationCount;
+    int max_makespan = std::max_element(population.begin(), population_end, byMakespanDecs)->makespan;
+    int min_makespan = std::min_element(population.begin(), population_end, byMakespanDecs)->makespan;
     int max_similarity = *std::max_element(similarity_degrees.begin(), similarity_degrees.end());
     int min_similarity = *std::min_element(similarity_degrees.begin(), similarity_degrees.end());
-    for (int i = 0; i < population.size(); i++) {
+    for (int i = 0; i < populationCount; i++) {
         auto qualityScore = calcQualityScore(population[i].makespan, similarity_degrees[i], max_makespan, min_makespan, max_similarity, min_similarity);
         quality_list.emplace_back(std::tuple<float,int>{qualityScore, i});
     }
     std::sort(quality_list.begin(), quality_list.end(), byQuality);
-    int e1 = std::get<0>(quality_list[0]);
-    int e2 = std::get<0>(quality_list[1]);
-    if (e1 < e2) {
-        population.erase(population.begin() + e2);
-        population.erase(population.begin() + e1);
-    } else {
-        population.erase(population.begin() + e1);
-        population.erase(population.begin() + e2);
+    // remove from the highest index, so the last solution moved into a gap is never one to remove
+    auto evicted = std::pmr::vector<int>(&scratchArena);
+    for (int i = 0; i < populationCount - populationSize; i++) evicted.emplace_back(std::get<1>(quality_list[i]));
+    std::sort(evicted.begin(), evicted.end(), std::greater<>());
+    for (int e: evicted) {
+        // the evicted solution goes to the free slot behind the population, its storage is reused by the next child
+        if (e != populationCount - 1) std::swap(population[e], population[populationCount - 1]);
+        --populationCount;
+        eraseSimilarityRow(e);
+    }
+}
+
+/**
+ * island model migration: passes copies of the migrationEliteCount best solutions to migrationExchange and replaces
+ * the worst solutions of the population with the returned immigrants, if they are better.
+ * immigrants already present in the population are skipped to keep the population diverse. Malformed immigrants are
+ * dropped, the makespan of the others is recomputed, the one of the sender is not trusted
+ */
+template<typename L>
+void MemeticEngine<L>::migrate() {
+    auto ranking = std::pmr::vector<int>(populationCount, &scratchArena);
+    std::iota(ranking.begin(), ranking.end(), 0);
+    std::sort(ranking.begin(), ranking.end(), [this](int a, int b) { return byMakespanDecs(population[a], population[b]); });
+    auto elite = vector<Solution>();
+    for (int i = 0; i < std::min(migrationEliteCount, populationCount); i++) {
+        elite.emplace_back(population[ranking[i]].toSolution());
+    }
+
+    for (auto &received: migrationExchange(elite)) {
+        if (!isWellFormed(received)) continue;
+        auto immigrant = FlatSolutionT(received);
+        // a cycle between the machine sequences is repaired instead of terminating
+        instance.calcMakespanAndFixSolution(immigrant, 0, &scratchArena);
+        auto population_end = population.begin() + populationCount;
+        auto worst = std::max_element(population.begin(), population_end, byMakespanDecs);
+        if (immigrant.makespan >= worst->makespan) continue;
+        bool duplicate = std::any_of(population.begin(), population_end,
+                                     [&immigrant](FlatSolutionT const &p) { return p.sequence == immigrant.sequence; });
+        if (duplicate) continue;
+        *worst = immigrant;
+        updateSimilarityRow(static_cast<int>(worst - population.begin()));
+        if (immigrant.makespan < currentBest.makespan) {
+            currentBest = immigrant;
+            logMakespan(currentBest.makespan);
+        }
+    }
+}
+
+template<typename L>
+bool MemeticEngine<L>::isWellFormed(Solution const &solution) {
+    if (solution.solution.size() != static_cast<size_t>(instance.machineCount)) return false;
+    auto seen = std::pmr::vector<uint8_t>(instance.jobCount, &scratchArena);
+    for (auto const &machine: solution.solution) {
+        if (machine.size() != static_cast<size_t>(instance.jobCount)) return false;
+        std::fill(seen.begin(), seen.end(), 0);
+        for (int job: machine) {
+            if (job < 0 || job >= instance.jobCount || seen[job]) return false;
+            seen[job] = 1;
+        }
     }
+    return true;
 }
 
 /**
@@ -279,39 +666,47 @@ void MemeticAlgorithm::updatePopulation() {
  * @param max_iterations
  * @return best solution
  */
-Solution MemeticAlgorithm::optimizeIterationConstraint(int max_iterations) {
+template<typename L>
+Solution MemeticEngine<L>::optimizeIterationConstraint(int max_iterations) {
     int current_iteration = 0;
-    population = vector<Solution>();
-    currentBest = Solution{vector<vector<int>>(), INT32_MAX};
+    populationCount = 0;
+    resetBest();
+    improvedCache.reset(improvedCacheCapacity, instance.operationCount());
+    archive.clear();
+    improvementIterations = tabuSearchIterations / 2.0;
     initializeRandPopulation();
-    for (auto &p: population) {
-        p = ts_algo.optimize_it(p, tabuSearchIterations);
+    for (int i = 0; i < populationCount; i++) {
+        auto &p = population[i];
+        p = ts_algo->optimize_it(p, tabuSearchIterations, 0);
+        archive.insert(p);
         if (p.makespan < currentBest.makespan) {
             currentBest = p;
         }
     }
     rng = std::mt19937(instance.getSeed());
     std::uniform_int_distribution<std::mt19937::result_type> dist(0,populationSize - 1);
+    resetSimilarityMatrix();
+    appendSimilarityRows();
 
     // main loop
     while (current_iteration++ < max_iterations) {
+        scratchArena.reset();
         auto parent_1 = dist(rng);
         auto parent_2 = dist(rng);
         while (parent_1 == parent_2) parent_2 = dist(rng);
 
-        auto children = recombinationOperator(population[parent_1], population[parent_2]);
+        recombinationOperator(population[parent_1], population[parent_2], offspring1, offspring2);
 
-        auto child_1 = ts_algo.optimize_it(std::get<0>(children), tabuSearchIterations);
-        auto child_2 = ts_algo.optimize_it(std::get<1>(children), tabuSearchIterations);
-        if (child_1.makespan < currentBest.makespan) {
-            currentBest = child_1;
-        }
-        if (child_2.makespan < currentBest.makespan) {
-            currentBest = child_2;
+        for (auto const *offspring: {&offspring1, &offspring2}) {
+            auto const *child = improveChild(*offspring, population[parent_1], population[parent_2]);
+            if (child != nullptr && child->makespan < currentBest.makespan) {
+                currentBest = *child;
+            }
         }
-        population.emplace_back(child_1);
-        population.emplace_back(child_2);
         updatePopulation();
     }
-    return currentBest;
-}
\ No newline at end of file
+    return currentBest.toSolution();
+}
+
+#define INSTANTIATE_MEMETIC(IndexT, TimeT) template class MemeticEngine<Layout<IndexT, TimeT>>;
+JSSP_LAYOUTS(INSTANTIATE_MEMETIC)
@@ -4,40 +4,124 @@
 #include "jssp.h"
 #include "ts.h"
 #include "heuristics.h"
+#include "arena.h"
+#include "solution_cache.h"
 #include <tuple>
 #include <chrono>
+#include <functional>
+#include <cstdint>
 
+/**
+ * metric for the similarity rating of the population
+ * lcs_similarity: sum of the longest common sequence lengths of each machine pair (Cheng et al.)
+ * precedence_distance: number of job pairs ordered equally on the same machine (number of all pairs - disjunctive pair
+ *                      distance), calculated with xor and popcount on packed bit vectors. Much cheaper than lcs
+ */
+enum DiversityMetric {lcs_similarity, precedence_distance};
 
-class MemeticAlgorithm {
+/**
+ * recombination operator of the memetic algorithm
+ * lcs_crossover: keep the longest common sequence of each machine and fill the gaps in the order of the other parent
+ * path_relinking: walk from one parent towards the other with N7 moves and take a solution from the middle of the
+ *                 path, see TabuSearchEngine::relink
+ */
+enum RecombinationOperator {lcs_crossover, path_relinking};
+
+/**
+ * how the crossover children are made feasible
+ * random_repair: JSSPInstance::calcMakespanAndFixSolution, blocked operations are moved forward in random order
+ * active_decoding: JSSPInstance::decodeActiveSchedule, Giffler-Thompson with the child's sequences as priorities
+ */
+enum ChildRepair {random_repair, active_decoding};
+
+/**
+ * interface of the memetic algorithm, independent of the layout. See MemeticAlgorithm
+ */
+class MemeticBase {
 public:
-    /**
-     * initialize.
-     * @param instance a valid JSSPInstance
-     * @param population_size number of solutions which are observed simultaneously
-     * @param tabu_search_iterations number of tabu search iterations executed on each new solution
-     * @param quality_score_beta weight for solution quality rating in [0,1]. Higher -> more importance to makespan
-     *                                                                        Lower -> more importance to similarity
-     */
-    explicit MemeticAlgorithm(JSSPInstance &instance, int population_size=30, int tabu_search_iterations=12000, float quality_score_beta=0.6) :
-            instance(instance), populationSize(population_size), tabuSearchIterations(tabu_search_iterations), qualityScoreBeta(quality_score_beta),
-            ts_algo(TabuSearch(instance)) {};
+    virtual ~MemeticBase() = default;
 
-    // mainly method for testing functionality
-    Solution optimizeIterationConstraint(int max_iterations);
+    virtual Solution optimizeIterationConstraint(int max_iterations) = 0;
+    virtual BMResult optimize(int time_limit, int lower_bound) = 0;
+    virtual BMResult optimizePopulation(int time_limit, vector<Solution> &start_solutions, int lower_bound) = 0;
+    virtual void start(vector<Solution> const &start_solutions, int lower_bound) = 0;
+    virtual bool step(long max_iterations, double seconds) = 0;
+    [[nodiscard]] virtual Solution best() const = 0;
+    virtual BMResult finish() = 0;
+    virtual void setTabuListParams(int _tt, int _d1, int _d2, unsigned int _tabuListSize) = 0;
+    virtual void setDiversityMetric(DiversityMetric metric) = 0;
+    virtual void setMigration(int interval, int elite_count, std::function<vector<Solution>(vector<Solution> const &)> exchange) = 0;
+    virtual void setDuplicateFilter(int near_duplicate_distance, int cache_capacity) = 0;
+    virtual void setRecombinationOperator(RecombinationOperator recombination) = 0;
+    virtual void setAdaptiveBudget(bool enabled) = 0;
+    virtual void setChildRepair(ChildRepair repair) = 0;
+    virtual void setTargetGap(double gap) = 0;
+    virtual void setImprovementCallback(ImprovementCallback callback) = 0;
+    virtual void setThreads(unsigned int threads) = 0;
+    [[nodiscard]] virtual vector<Solution> elites() const = 0;
+};
 
-    // optimize with a time limit in seconds, known optimum or LB for early stop (0 if unknown)
-    BMResult optimize(int time_limit, int lower_bound=0);
+/**
+ * the memetic algorithm implementation, population and tabu search run on the layout L, see layout.h
+ */
+template<typename L>
+class MemeticEngine : public MemeticBase {
+public:
+    using IndexT = typename L::Index;
+    using TimeT = typename L::Time;
+    using FlatSolutionT = BasicFlatSolution<IndexT, TimeT>;
 
-    // optimize with a time limit in seconds, known optimum or LB for early stop and a population of staring solutions
-    BMResult optimizePopulation(int time_limit, vector<Solution> &start_solutions, int lower_bound=0);
+    MemeticEngine(JSSPInstance &instance, int population_size, int tabu_search_iterations, float quality_score_beta) :
+            instance(instance), ts_algo(makeTabuSearch<L>(instance)), tabuSearchIterations(tabu_search_iterations),
+            populationSize(population_size), qualityScoreBeta(quality_score_beta),
+            archive(10, std::max(3, instance.operationCount() / 20)) {};
 
-    // OPTIONAL: set tabu list parameters -> influence how long items are forbidden. See tabuList for details.
-    void setTabuListParams(int _tt=2, int _d1=5, int _d2=12, unsigned int _tabuListSize= 0) {
-        ts_algo.setTabuListParams(_tt, _d1, _d2, _tabuListSize);};
+    Solution optimizeIterationConstraint(int max_iterations) override;
+
+    BMResult optimize(int time_limit, int lower_bound) override;
+
+    BMResult optimizePopulation(int time_limit, vector<Solution> &start_solutions, int lower_bound) override;
+
+    void start(vector<Solution> const &start_solutions, int lower_bound) override;
+
+    bool step(long max_iterations, double seconds) override;
+
+    [[nodiscard]] Solution best() const override { return currentBest.toSolution(); };
+
+    BMResult finish() override { return bestResult(); };
+
+    void setTabuListParams(int _tt, int _d1, int _d2, unsigned int _tabuListSize) override {
+        ts_algo->setTabuListParams(_tt, _d1, _d2, _tabuListSize);};
+
+    void setDiversityMetric(DiversityMetric metric) override { diversityMetric = metric; };
+
+    void setMigration(int interval, int elite_count, std::function<vector<Solution>(vector<Solution> const &)> exchange) override {
+        migrationInterval = interval; migrationEliteCount = elite_count; migrationExchange = std::move(exchange);};
+
+    void setDuplicateFilter(int near_duplicate_distance, int cache_capacity) override {
+        nearDuplicateDistance = near_duplicate_distance; improvedCacheCapacity = cache_capacity;
+        improvedCache.reset(improvedCacheCapacity, instance.operationCount());};
+
+    void setRecombinationOperator(RecombinationOperator recombination) override { recombinationOperatorType = recombination; };
+
+    void setAdaptiveBudget(bool enabled) override { adaptiveBudget = enabled; };
+
+    void setChildRepair(ChildRepair repair) override { childRepair = repair; };
+
+    void setTargetGap(double gap) override { targetGap = gap; };
+
+    void setImprovementCallback(ImprovementCallback callback) override { improvementCallback = std::move(callback); };
+
+    void setThreads(unsigned int threads) override { initializationThreads = threads; };
+
+    [[nodiscard]] vector<Solution> elites() const override { return archive.toSolutions(); };
 
 private:
+    // the checks in tests/ compare the internals with reference implementations
+    friend struct MemeticCheck;
+
     JSSPInstance &instance;
-    TabuSearch ts_algo;
+    std::unique_ptr<TabuSearchCore<IndexT, TimeT>> ts_algo;
     // iterations of each tabu search call.
     const int tabuSearchIterations;
     // population size.
@@ -45,38 +129,150 @@ private:
     // constant for quality score weighting
     const float qualityScoreBeta;
 
+    // migration settings, disabled if migrationInterval is 0. See setMigration
+    int migrationInterval = 0;
+    int migrationEliteCount = 0;
+    std::function<vector<Solution>(vector<Solution> const &)> migrationExchange;
+
     // logging intermediate makespans while running
     vector<std::tuple<double, int>> makespanHistory;
+    // streaming of new best solutions, see setImprovementCallback
+    ImprovementCallback improvementCallback;
 
     // rng module
     std::mt19937 rng;
     // starting time for logging
     std::chrono::time_point<std::chrono::system_clock> tStart;
-    // population for the memetic algorithm
-    vector<Solution> population;
+    // population for the memetic algorithm: the first populationCount slots. The slots behind keep the storage of evicted
+    // solutions for the next children, see appendMember
+    vector<FlatSolutionT> population;
+    int populationCount = 0;
+    // pairwise similarities of the population, similarityMatrix[i * similarityStride + j] = calcSimilarity(i, j).
+    // allocated once per run, evicted solutions are replaced by the last solution of the population
+    vector<int> similarityMatrix;
+    int similarityStride = 0;
+    // number of solutions of the population with an up to date row in similarityMatrix
+    int similarityRows = 0;
+    // similarity rating metric, and the metric of the current similarityMatrix
+    DiversityMetric diversityMetric = lcs_similarity;
+    DiversityMetric runDiversityMetric = lcs_similarity;
+    // operator which creates the children
+    RecombinationOperator recombinationOperatorType = lcs_crossover;
+    // repair of the crossover children, see setChildRepair
+    ChildRepair childRepair = random_repair;
+    // a run stops when the relative gap to the lower bound of the instance is reached, see JSSPInstance::stopMakespan
+    double targetGap = 0;
+    // best mutually distant solutions of the run, all tabu search results are offered
+    BasicEliteArchive<IndexT, TimeT> archive;
+    // packed job pair orderings of each solution of the population, only maintained for precedence_distance
+    vector<vector<uint64_t>> precedenceBits;
+    // scratch memory of one generation, reset at the start of each generation
+    ScratchArena scratchArena;
+    // reused storage for the two children of the recombination operator
+    FlatSolutionT offspring1, offspring2;
+    // fingerprint cache: solution passed to the tabu search -> local optimum the search reached. cleared at the start
+    // of each run and when it reaches improvedCacheCapacity entries. 0: disabled, see setDuplicateFilter
+    BasicSolutionCache<IndexT, TimeT> improvedCache;
+    int improvedCacheCapacity = 0;
+    // children with fewer differing positions to a solution of the population are not optimized, see improveChild.
+    // 0: disabled
+    int nearDuplicateDistance = 0;
+    // adapt the tabu search budget of each child, see optimizeChild. See setAdaptiveBudget
+    bool adaptiveBudget = false;
+    // threads of the random initialization, 0: all cores. See setThreads
+    unsigned int initializationThreads = 0;
+    // moving average of the iteration of the last improvement in the tabu searches of the children
+    double improvementIterations = 0;
     // current best solution
-    Solution currentBest;
+    FlatSolutionT currentBest;
+    // state of the run of start and step: makespan at which it stops, number of population members which went through
+    // the tabu search and generations since the start of the main loop
+    int runStopMakespan = 0;
+    size_t optimizedMembers = 0;
+    long generation = 0;
+
+    // tabu search on the next population member of the initialization
+    void optimizeMember();
+
+    // prepare the main loop, after the initialization
+    void startGenerations();
+
+    // one generation of the main loop: recombination, tabu search of the children, selection and migration
+    void runGeneration();
 
-    // main algorithm loop, called by both optimize and optimizePopulation
-    void optimizeLoop(int time_limit, int known_optimum);
+    // reset currentBest before a run
+    void resetBest();
+
+    // result of a run: currentBest and the makespan history
+    [[nodiscard]] BMResult bestResult() const;
 
     // init the population random at the start of the memetic algo
     void initializeRandPopulation();
 
-    // create child solution from two parent solutions
-    std::tuple<Solution, Solution> recombinationOperator(Solution const &parent_1, Solution const &parent_2);
+    // appends a slot to the population and returns it for writing, it keeps the storage of an evicted solution
+    FlatSolutionT &appendMember();
+
+    // 64 bit fingerprint of the machine sequences of a solution
+    static uint64_t fingerprint(FlatSolutionT const &solution);
+
+    // optimize a child with the tabu search or take the result from the cache and append it to the population.
+    // returns nullptr for a rejected near duplicate
+    FlatSolutionT const *improveChild(FlatSolutionT const &child, FlatSolutionT const &parent_1, FlatSolutionT const &parent_2);
+
+    // tabu search on a child with the (adaptive) iteration budget
+    FlatSolutionT const &optimizeChild(FlatSolutionT const &child, int parent_distance);
+
+    // create two child solutions from two parent solutions, written to the given children
+    void recombinationOperator(FlatSolutionT const &parent_1, FlatSolutionT const &parent_2, FlatSolutionT &child_1, FlatSolutionT &child_2);
 
-    // find Longest Common Sequence of the two machines
-    static vector<int> crossover(vector<int> const &machine_parent_1, vector<int> const &machine_parent_2, vector<int> const &lcs);
-    static vector<int> findLongestCommonSequence(const vector<int> &machine_1, const vector<int> &machine_2);
+    // find Longest Common Sequence of the two machines, all machine sequences have job_count jobs
+    static void crossover(IndexT const *machine_parent_1, IndexT const *machine_parent_2, int job_count, std::pmr::vector<IndexT> const &lcs,
+                          IndexT *child_sequence, std::pmr::memory_resource *memory = std::pmr::get_default_resource());
+    static std::pmr::vector<IndexT> findLongestCommonSequence(IndexT const *machine_1, IndexT const *machine_2, int job_count,
+                                                              std::pmr::memory_resource *memory = std::pmr::get_default_resource());
+    // length of the Longest Common Sequence of the two machines, without reconstruction
+    static int lcsLength(IndexT const *machine_1, IndexT const *machine_2, int job_count,
+                         std::pmr::memory_resource *memory = std::pmr::get_default_resource());
 
     // calculate Similarity Degree of a solution to the current population
     int calcSimilarityDegree(int solution_index);
 
-    // call at the end of each operation. takes a population with size = populationSize + 2
-    // and removes the 2 individuals with the lowest quality score
+    // similarity of the solutions at both indices of the population, according to diversityMetric
+    int calcSimilarity(int solution_index_1, int solution_index_2);
+
+    // pack the job pair orderings of each machine of a solution into a bit vector, see precedence_distance
+    void calcPrecedenceBits(FlatSolutionT const &solution, vector<uint64_t> &bits);
+
+    // number of job pairs ordered differently on the same machine, xor + popcount of the precedence bits
+    static int precedenceDistance(vector<uint64_t> const &bits_1, vector<uint64_t> const &bits_2);
+
+    // (re)allocate similarityMatrix for the current population, rows are calculated by appendSimilarityRows
+    void resetSimilarityMatrix();
+
+    // extend similarityMatrix by the rows of all solutions appended to the population since the last call
+    void appendSimilarityRows();
+
+    // recalculate the row of a solution which was replaced in place
+    void updateSimilarityRow(int solution_index);
+
+    // remove the row and column of an evicted solution, the last row takes its place
+    void eraseSimilarityRow(int solution_index);
+
+    // access to similarityMatrix
+    inline int &similarity(int solution_index_1, int solution_index_2) {
+        return similarityMatrix[solution_index_1 * similarityStride + solution_index_2];
+    };
+
+    // call at the end of each operation. takes a population with size populationSize + 0..2
+    // and removes the individuals with the lowest quality score down to populationSize
     void updatePopulation();
 
+    // send the elite to the other islands and replace the worst solutions with the received immigrants
+    void migrate();
+
+    // each machine sequence of the received solution is a permutation of the jobs of the instance
+    [[nodiscard]] bool isWellFormed(Solution const &solution);
+
     // log makespan method to save the time and new best makespan while running
     void logMakespan(int makespan);
 
@@ -96,10 +292,93 @@ private:
     };
 
     // sorting function
-    static inline bool byMakespanDecs(Solution const &a, Solution const &b) {
+    static inline bool byMakespanDecs(FlatSolutionT const &a, FlatSolutionT const &b) {
         return a.makespan < b.makespan;
     }
 };
 
+/**
+ * memetic algorithm for the job shop scheduling problem. Runs on the narrowest layout which fits the instance, see
+ * layout.h
+ */
+class MemeticAlgorithm {
+public:
+    /**
+     * initialize.
+     * @param instance a valid JSSPInstance
+     * @param population_size number of solutions which are observed simultaneously
+     * @param tabu_search_iterations number of tabu search iterations executed on each new solution
+     * @param quality_score_beta weight for solution quality rating in [0,1]. Higher -> more importance to makespan
+     *                                                                        Lower -> more importance to similarity
+     */
+    explicit MemeticAlgorithm(JSSPInstance &instance, int population_size=30, int tabu_search_iterations=12000, float quality_score_beta=0.6);
+
+    // mainly method for testing functionality
+    Solution optimizeIterationConstraint(int max_iterations) { return engine->optimizeIterationConstraint(max_iterations); };
+
+    // optimize with a time limit in seconds, known optimum or LB for early stop (0 if unknown)
+    BMResult optimize(int time_limit, int lower_bound=0) { return engine->optimize(time_limit, lower_bound); };
+
+    // optimize with a time limit in seconds, known optimum or LB for early stop and a population of staring solutions
+    BMResult optimizePopulation(int time_limit, vector<Solution> &start_solutions, int lower_bound=0) {
+        return engine->optimizePopulation(time_limit, start_solutions, lower_bound); };
+
+    // resumable run, the same algorithm as optimizePopulation in slices, so one thread can interleave many runs: start a
+    // run with start solutions (the rest of the population is random), continue it with step for max_iterations
+    // iterations (the tabu search of one population member or one generation) and / or seconds (0: no limit, set at
+    // least one), best solution so far with best (empty before the first tabu search), result with finish. The run is
+    // kept between the calls, step returns false when the lower bound is reached
+    void start(vector<Solution> const &start_solutions={}, int lower_bound=0) { engine->start(start_solutions, lower_bound); };
+    bool step(long max_iterations, double seconds=0) { return engine->step(max_iterations, seconds); };
+    [[nodiscard]] Solution best() const { return engine->best(); };
+    BMResult finish() { return engine->finish(); };
+
+    // OPTIONAL: set tabu list parameters -> influence how long items are forbidden. See tabuList for details.
+    void setTabuListParams(int _tt=2, int _d1=5, int _d2=12, unsigned int _tabuListSize= 0) {
+        engine->setTabuListParams(_tt, _d1, _d2, _tabuListSize);};
+
+    // OPTIONAL: select the metric for the similarity rating of the population, from the next run on. See DiversityMetric
+    void setDiversityMetric(DiversityMetric metric) { engine->setDiversityMetric(metric); };
+
+    // OPTIONAL: every interval generations hand the elite_count best solutions to exchange and merge the returned
+    // immigrants into the population. Used by the island model, see island.h
+    void setMigration(int interval, int elite_count, std::function<vector<Solution>(vector<Solution> const &)> exchange) {
+        engine->setMigration(interval, elite_count, std::move(exchange));};
+
+    // OPTIONAL: select the operator which creates the children. See RecombinationOperator
+    void setRecombinationOperator(RecombinationOperator recombination) { engine->setRecombinationOperator(recombination); };
+
+    // best mutually distant solutions found by the last run, best first
+    [[nodiscard]] vector<Solution> elites() const { return engine->elites(); };
+
+    // OPTIONAL: enable / disable the adaptive tabu search budget of the children, see MemeticEngine::optimizeChild.
+    // Off by default
+    void setAdaptiveBudget(bool enabled) { engine->setAdaptiveBudget(enabled); };
+
+    // OPTIONAL: select how crossover children are made feasible, random_repair by default. See ChildRepair
+    void setChildRepair(ChildRepair repair) { engine->setChildRepair(repair); };
+
+    // OPTIONAL: a run stops, when the makespan is within the relative gap of the instance lower bound
+    // (JSSPInstance::lowerBound). 0: stop only at a proven optimum
+    void setTargetGap(double gap=0) { engine->setTargetGap(gap); };
+
+    // OPTIONAL: optimize and optimizePopulation call callback with each new best solution, e.g. to stream them to a
+    // client while the run continues. Empty: no calls
+    void setImprovementCallback(ImprovementCallback callback={}) { engine->setImprovementCallback(std::move(callback)); };
+
+    // OPTIONAL: children which differ from a solution of the population in less than near_duplicate_distance sequence positions are
+    // dropped without a tabu search, children seen before take the cached tabu search result (up to cache_capacity
+    // entries, 0 disables the cache). Off by default
+    void setDuplicateFilter(int near_duplicate_distance=2, int cache_capacity=4096) {
+        engine->setDuplicateFilter(near_duplicate_distance, cache_capacity);};
+
+    // OPTIONAL: number of threads which generate the random start solutions, 0: all cores. The rest of the algorithm
+    // runs on the calling thread, so 1 keeps a run on a single core (e.g. inside a thread pool or an island process)
+    void setThreads(unsigned int threads=0) { engine->setThreads(threads); };
+
+private:
+    std::unique_ptr<MemeticBase> engine;
+};
+
 
 #endif //HYBRID_EVO_ALGORITHM_MEM_H
@@ -0,0 +1,77 @@
+#ifndef HYBRID_EVO_ALGORITHM_NEIGHBOURHOOD_H
+#define HYBRID_EVO_ALGORITHM_NEIGHBOURHOOD_H
+
+/**
+ * neighbourhood structures of the tabu search, all move operations inside the blocks of a longest path
+ * n5: swap the first two and the last two operations of each block (Nowicki and Smutnicki). Smallest neighbourhood,
+ *     most iterations per second
+ * n6: move an operation to the beginning or the end of its block (Balas and Vazacopoulos)
+ * n7: n6 and additionally move the first or the last operation to every position of the block (Zhang et al.)
+ */
+enum NeighbourhoodStructure {n5, n6, n7};
+
+/**
+ * neighbourhood policies of the tabu search, selected at compile time, see TabuSearchEngine.
+ * generate is called for each block of the longest path with moves, which provides
+ * canMoveForward(u, v) / forward(u, v): test and add the move of the operation at u behind the operation at v
+ * canMoveBackward(u, v) / backward(u, v): test and add the move of the operation at v before the operation at u
+ * path_start / path_end tell if the block starts / ends the longest path. Blocks of size 2 have a single adjacent swap
+ */
+struct N5Neighbourhood {
+    template<typename Moves>
+    static inline void generate(Moves &moves, int block_size, bool path_start, bool path_end) {
+        int last = block_size - 1;
+        // swapping the first operations of the first block or the last operations of the last block can not improve
+        if (!path_start) moves.forward(0, 1);
+        if (!path_end && (block_size > 2 || path_start)) moves.forward(last - 1, last);
+    }
+};
+
+struct N6Neighbourhood {
+    template<typename Moves>
+    static inline void generate(Moves &moves, int block_size, bool /*path_start*/, bool /*path_end*/) {
+        int last = block_size - 1;
+        if (block_size == 2) {
+            moves.forward(0, 1);
+            return;
+        }
+        for (int u = 0; u < last; u++) {
+            // move operations behind the last
+            if (moves.canMoveForward(u, last)) moves.forward(u, last);
+        }
+        for (int v = 1; v < block_size; v++) {
+            // move operations before the first
+            if (moves.canMoveBackward(0, v)) moves.backward(0, v);
+        }
+    }
+};
+
+struct N7Neighbourhood {
+    template<typename Moves>
+    static inline void generate(Moves &moves, int block_size, bool /*path_start*/, bool /*path_end*/) {
+        int last = block_size - 1;
+        if (block_size == 2) {
+            moves.forward(0, 1);
+            return;
+        }
+        for (int u = 1; u < last; u++) {
+            // move middle operations behind the last
+            if (moves.canMoveForward(u, last)) moves.forward(u, last);
+        }
+        for (int v = 1; v < block_size; v++) {
+            // move first operation behind every operation
+            if (moves.canMoveForward(0, v)) moves.forward(0, v);
+        }
+        for (int v = 1; v < last; v++) {
+            // move middle operations before first
+            if (moves.canMoveBackward(0, v)) moves.backward(0, v);
+        }
+        for (int u = 0; u < last; u++) {
+            // move last operation before every operation
+            if (moves.canMoveBackward(u, last)) moves.backward(u, last);
+        }
+    }
+};
+
+
+#endif //HYBRID_EVO_ALGORITHM_NEIGHBOURHOOD_H
@@ -0,0 +1,303 @@
+#include <iostream>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include "reschedule.h"
+
+Rescheduler::Rescheduler(JSSPInstance &instance, Solution const &solution):
+        shop(std::make_unique<JSSPInstance>(instance.instance, static_cast<int>(instance.getSeed()))),
+        sequences(solution.solution), started(instance.machineCount, 0), release(instance.operationCount(), 0) {
+    createSearch();
+    int machine_count = shop->machineCount;
+    for (int job = 0; job < shop->jobCount; job++) {
+        for (int index = 0; index < machine_count; index++) {
+            operationIds[job * machine_count + shop->instance[job][index].machine] = job * machine_count + index;
+        }
+    }
+    evaluate();
+    repair();
+}
+
+void Rescheduler::createSearch() {
+    int op_count = shop->operationCount();
+    operationIds.resize(op_count);
+    graph.resize(op_count);
+    topologicalOrder.resize(op_count);
+    predecessorCount.resize(op_count);
+    start.resize(op_count);
+    rank.resize(op_count);
+    queued.resize(op_count, 0);
+    touched.resize(shop->machineCount, 0);
+    // release times grow with the clock, so the search always uses 32 bit times, see selectLayout
+    search.reset();
+    search = std::make_unique<TabuSearch>(*shop, n7, std::numeric_limits<uint16_t>::max());
+    search->setKeepTabuList(true);
+}
+
+/**
+ * the lower bound of the instance is updated once before a search run, not with each changed duration
+ */
+void Rescheduler::updateLowerBound() {
+    if (!boundOutdated) return;
+    shop->updateLowerBound();
+    boundOutdated = false;
+}
+
+int Rescheduler::operationAt(int machine, int position) const {
+    return operationIds[sequences[machine][position] * shop->machineCount + machine];
+}
+
+int Rescheduler::endTime(int op) const {
+    return start[op] + shop->instance[op / shop->machineCount][op % shop->machineCount].duration;
+}
+
+/**
+ * moves the clock forward, operations which started before the new time keep their start time and position. Blocks
+ * which are over are dropped. No start time changes, all other operations start at the new time or later already, only
+ * their release times are raised for the tabu search
+ * @param time new current time, earlier times are ignored
+ */
+void Rescheduler::advance(int time) {
+    if (time <= clock) return;
+    clock = time;
+    for (int machine = 0; machine < shop->machineCount; machine++) {
+        while (started[machine] < shop->jobCount && start[operationAt(machine, started[machine])] < clock) {
+            int op = operationAt(machine, started[machine]);
+            release[op] = start[op];
+            ++started[machine];
+        }
+        for (int position = started[machine]; position < shop->jobCount; position++) {
+            int op = operationAt(machine, position);
+            release[op] = std::max(release[op], clock);
+        }
+    }
+    machineBlocks.erase(std::remove_if(machineBlocks.begin(), machineBlocks.end(),
+                                       [this](MachineBlock const &block) { return block.to <= clock; }), machineBlocks.end());
+    repair();
+}
+
+/**
+ * adds a job, which can start at the current time, at the end of each machine sequence. Operation ids of the old jobs
+ * do not change. The new operations are linked behind the last ones of their machines and come last in the
+ * topological order, only their start times are computed
+ * @param operations machine and duration of each operation
+ * @return job number
+ */
+int Rescheduler::addJob(vector<Operation> const &operations) {
+    int job = shop->jobCount;
+    auto jobs = shop->instance;
+    jobs.push_back(operations);
+    for (auto &operation: jobs.back()) operation.job = job;
+    for (auto &sequence: sequences) sequence.push_back(job);
+    release.resize(release.size() + operations.size(), clock);
+
+    int seed = static_cast<int>(shop->getSeed());
+    search.reset();
+    shop = std::make_unique<JSSPInstance>(std::move(jobs), seed);
+    boundOutdated = false;
+    createSearch();
+    int machine_count = shop->machineCount;
+    for (int index = 0; index < machine_count; index++) {
+        int op = job * machine_count + index;
+        auto const &operation = shop->instance[job][index];
+        operationIds[job * machine_count + operation.machine] = op;
+        int predecessor = job > 0 ? operationAt(operation.machine, job - 1) : nil;
+        graph[op] = Node{index > 0 ? op - 1 : nil, predecessor, index < machine_count - 1 ? op + 1 : nil, nil,
+                         operation.machine, job, 0, operation.duration, 0};
+        if (predecessor != nil) graph[predecessor].machSuccessor = op;
+        rank[op] = op;
+        start[op] = 0;
+        // behind all blocks of the machine
+        for (auto const &block: machineBlocks) {
+            if (block.machine == operation.machine) release[op] = std::max(release[op], block.to);
+        }
+        enqueue(op);
+    }
+    repair();
+    return job;
+}
+
+/**
+ * the start times behind the operation are recomputed
+ */
+void Rescheduler::changeDuration(int job, int index, int duration) {
+    shop->setDuration(job, index, duration, false);
+    boundOutdated = true;
+    int op = job * shop->machineCount + index;
+    graph[op].duration = duration;
+    touch(graph[op].machine);
+    enqueue(graph[op].jobSuccessor);
+    enqueue(graph[op].machSuccessor);
+    repair();
+}
+
+/**
+ * blocks a machine: the operations which end before from in the current schedule stay in front of the block, all
+ * others move behind it. A running operation is interrupted and resumed after the block, its duration grows by the
+ * length of the block
+ * @param machine
+ * @param from start of the block, at least the current time
+ * @param to end of the block
+ */
+void Rescheduler::blockMachine(int machine, int from, int to) {
+    from = std::max(from, clock);
+    if (to <= from) return;
+    int position = started[machine];
+    if (position > 0 && endTime(operationAt(machine, position - 1)) > from) {
+        int op = operationAt(machine, position - 1);
+        int job = op / shop->machineCount;
+        int index = op % shop->machineCount;
+        shop->setDuration(job, index, shop->instance[job][index].duration + to - from, false);
+        boundOutdated = true;
+        graph[op].duration = shop->instance[job][index].duration;
+        enqueue(graph[op].jobSuccessor);
+        enqueue(graph[op].machSuccessor);
+    }
+    while (position < shop->jobCount && endTime(operationAt(machine, position)) <= from) ++position;
+    machineBlocks.push_back(MachineBlock{machine, from, to, position});
+    for (; position < shop->jobCount; position++) {
+        int op = operationAt(machine, position);
+        if (release[op] < to) {
+            release[op] = to;
+            enqueue(op);
+        }
+    }
+    touch(machine);
+    repair();
+}
+
+/**
+ * continue the tabu search with its tabu list, see TabuSearch::optimize. The result is repaired, if an operation in
+ * front of a block got later than the block start
+ * @param seconds
+ * @return BMResult of the search with the repaired schedule
+ */
+BMResult Rescheduler::optimize(int seconds) {
+    updateLowerBound();
+    Solution current = solution();
+    BMResult result = search->optimize(current, seconds);
+    sequences = result.solution;
+    evaluate();
+    repair();
+    result.solution = sequences;
+    result.makespan = makespan;
+    result.gap = relativeGap(makespan, result.lowerBound);
+    return result;
+}
+
+Solution Rescheduler::optimize_it(long max_iterations) {
+    updateLowerBound();
+    Solution current = solution();
+    sequences = search->optimize_it(current, max_iterations).solution;
+    evaluate();
+    repair();
+    return solution();
+}
+
+/**
+ * graph and start times of the current sequences, see calcHeadsAndTails. All machines are checked against their
+ * blocks by the next repair. Terminates on an infeasible solution
+ */
+void Rescheduler::evaluate() {
+    int machine_count = shop->machineCount;
+    int op_count = shop->operationCount();
+    for (int job = 0; job < shop->jobCount; job++) {
+        for (int index = 0; index < machine_count; index++) {
+            int op = job * machine_count + index;
+            auto const &operation = shop->instance[job][index];
+            graph[op] = Node{index > 0 ? op - 1 : nil, nil, index < machine_count - 1 ? op + 1 : nil, nil,
+                             operation.machine, job, 0, operation.duration, 0};
+        }
+    }
+    for (int machine = 0; machine < machine_count; machine++) {
+        int predecessor = nil;
+        for (int position = 0; position < shop->jobCount; position++) {
+            int op = operationAt(machine, position);
+            graph[op].machPredecessor = predecessor;
+            if (predecessor != nil) graph[predecessor].machSuccessor = op;
+            predecessor = op;
+        }
+        touch(machine);
+    }
+    if (calcHeadsAndTails(graph.data(), op_count, nil, topologicalOrder.data(), predecessorCount.data(),
+                          release.data()) < 0) {
+        std::cout << "Error in solution detected. Terminating..." << std::endl;
+        exit(1);
+    }
+    for (int op = 0; op < op_count; op++) start[op] = graph[op].start;
+    for (int position = 0; position < op_count; position++) rank[topologicalOrder[position]] = position;
+}
+
+void Rescheduler::enqueue(int op) {
+    if (op == nil || queued[op]) return;
+    queued[op] = 1;
+    pending.emplace_back(rank[op], op);
+    std::push_heap(pending.begin(), pending.end(), std::greater<>());
+}
+
+void Rescheduler::touch(int machine) {
+    if (touched[machine]) return;
+    touched[machine] = 1;
+    touchedMachines.push_back(machine);
+}
+
+/**
+ * the queued operations in topological order: an operation is visited after all its predecessors with changed start
+ * times, so once. Its successors are queued if its start time changes
+ */
+void Rescheduler::propagate() {
+    while (!pending.empty()) {
+        std::pop_heap(pending.begin(), pending.end(), std::greater<>());
+        int op = pending.back().second;
+        pending.pop_back();
+        queued[op] = 0;
+        auto const &node = graph[op];
+        int value = release[op];
+        if (node.jobPredecessor != nil) value = std::max(value, endTime(node.jobPredecessor));
+        if (node.machPredecessor != nil) value = std::max(value, endTime(node.machPredecessor));
+        if (value == start[op]) continue;
+        start[op] = value;
+        touch(node.machine);
+        enqueue(node.jobSuccessor);
+        enqueue(node.machSuccessor);
+    }
+}
+
+/**
+ * start times from the queued operations. The blocks of the machines with changed start times are checked: the
+ * operations in front of a block which end after its start are moved behind it with all later ones, their release time
+ * becomes the block end and the start times are propagated again, until the schedule respects all blocks. The
+ * positions up to the last block and the release times are handed to the tabu search
+ */
+void Rescheduler::repair() {
+    propagate();
+    while (!touchedMachines.empty()) {
+        for (auto &block: machineBlocks) {
+            if (!touched[block.machine]) continue;
+            // the end times of a machine sequence do not decrease, the overlapping operations are the last ones
+            int position = block.position;
+            while (position > started[block.machine] && endTime(operationAt(block.machine, position - 1)) > block.from) {
+                --position;
+            }
+            for (; block.position > position; --block.position) {
+                int op = operationAt(block.machine, block.position - 1);
+                if (release[op] < block.to) {
+                    release[op] = block.to;
+                    enqueue(op);
+                }
+            }
+        }
+        for (int machine: touchedMachines) touched[machine] = 0;
+        touchedMachines.clear();
+        propagate();
+    }
+
+    makespan = 0;
+    for (int job = 0; job < shop->jobCount; job++) {
+        makespan = std::max(makespan, endTime((job + 1) * shop->machineCount - 1));
+    }
+    auto fixed = started;
+    for (auto const &block: machineBlocks) fixed[block.machine] = std::max(fixed[block.machine], block.position);
+    search->setReleaseTimes(release);
+    search->setFixedPrefix(fixed);
+}
@@ -0,0 +1,134 @@
+#ifndef HYBRID_EVO_ALGORITHM_RESCHEDULE_H
+#define HYBRID_EVO_ALGORITHM_RESCHEDULE_H
+
+#include <memory>
+#include "jssp.h"
+#include "ts.h"
+#include "disjunctive_graph.h"
+
+/**
+ * unavailability of a machine in [from, to). The first position jobs of the machine sequence run before it, all later
+ * ones after it
+ */
+struct MachineBlock {
+    int machine;
+    int from;
+    int to;
+    int position;
+};
+
+/**
+ * warm start rescheduling of a running shop: the session keeps the current schedule and one tabu search, shop events
+ * change them in place and the search continues from the repaired schedule with its tabu list, instead of starting
+ * over. Time only moves forward (advance): operations which started before the current time are fixed, all others
+ * start at the current time or later.
+ * The events are translated into the rescheduling options of the tabu search (TabuSearch::setReleaseTimes and
+ * setFixedPrefix): started operations keep their position and start time, operations behind a machine block get its end
+ * as release time, operations in front of it keep their positions. A repair is not a new search: the start times are
+ * propagated forward from the operations the event touches (the changed operation, the machine suffix behind a block,
+ * the new job) in topological order, and only the blocks of machines with changed start times are checked again.
+ * The full schedule is recomputed only for the new sequences of a search run. Adding a job still copies the instance
+ * and rebuilds the tabu search, their buffers are sized for the shape of the instance
+ */
+class Rescheduler {
+public:
+    // session on a copy of the instance, starting at time 0 with the given solution
+    Rescheduler(JSSPInstance &instance, Solution const &solution);
+
+    // moves the clock forward to time, operations which started before it are fixed
+    void advance(int time);
+
+    /**
+     * a new job arrives at the current time, its operations are appended to the machine sequences. The tabu search is
+     * rebuilt for the new shape of the instance, so its tabu list is lost
+     * @param operations machine and duration of each operation, one per machine
+     * @return job number of the new job
+     */
+    int addJob(vector<Operation> const &operations);
+
+    // the index-th operation of the job takes duration instead, also for a running operation
+    void changeDuration(int job, int index, int duration);
+
+    // the machine is not available in [from, to), from is moved to the current time if it is earlier. An operation
+    // which runs at from is interrupted and resumed at to
+    void blockMachine(int machine, int from, int to);
+
+    // continue the tabu search on the current schedule for a number of seconds
+    BMResult optimize(int seconds);
+
+    // continue the tabu search on the current schedule for max_iterations iterations, for a bounded replanning latency
+    Solution optimize_it(long max_iterations);
+
+    // current schedule: machine sequences and makespan
+    [[nodiscard]] Solution solution() const { return Solution{sequences, makespan}; };
+
+    // start time of each operation of the current schedule, operation id job * #machines + index in the job
+    [[nodiscard]] vector<int> const &startTimes() const { return start; };
+
+    [[nodiscard]] int now() const { return clock; };
+
+    // current jobs and durations, the lower bound is updated by the next search run
+    [[nodiscard]] JSSPInstance const &instance() const { return *shop; };
+
+    [[nodiscard]] vector<MachineBlock> const &blocks() const { return machineBlocks; };
+
+private:
+    using Node = BasicNode<int, int>;
+    static constexpr int nil = -1;
+
+    std::unique_ptr<JSSPInstance> shop;
+    std::unique_ptr<TabuSearch> search;
+    vector<vector<int>> sequences;
+    int clock = 0;
+    // started[m]: number of operations of machine m which started before clock
+    vector<int> started;
+    // release time of each operation, the fixed start time for started operations
+    vector<int> release;
+    vector<MachineBlock> machineBlocks;
+    // a duration changed since the last update of the lower bound of shop
+    bool boundOutdated = false;
+    // operationIds[job * #machines + machine]: id of the operation of the job on the machine
+    vector<int> operationIds;
+
+    // start times of the current schedule and its makespan
+    vector<int> start;
+    int makespan = 0;
+    vector<Node> graph;
+    vector<int> topologicalOrder;
+    vector<uint8_t> predecessorCount;
+    // position of each operation in a topological order of the graph, see propagate
+    vector<int> rank;
+    // heap of (rank, operation) of the operations whose start time has to be recomputed, queued: operation is in it
+    vector<std::pair<int, int>> pending;
+    vector<uint8_t> queued;
+    // machines with changed start times or durations since the last check of their blocks
+    vector<int> touchedMachines;
+    vector<uint8_t> touched;
+
+    // buffers and tabu search for the current shape of the instance
+    void createSearch();
+
+    // lower bound of shop after changed durations, for the tabu search
+    void updateLowerBound();
+
+    // operation at a position of a machine sequence and its end in the current schedule
+    [[nodiscard]] int operationAt(int machine, int position) const;
+    [[nodiscard]] int endTime(int op) const;
+
+    // graph and start times of the current sequences with the current release times
+    void evaluate();
+
+    // recompute the start time of op, and of its successors if it changes
+    void enqueue(int op);
+    // the machine has to be checked against its blocks
+    void touch(int machine);
+    // start times of the queued operations and of all operations behind them whose start time changes
+    void propagate();
+
+    // start times after an event, from the queued operations. Operations in front of a block which end after its start
+    // are moved behind it. Hands the release times and fixed positions to the tabu search
+    void repair();
+};
+
+
+#endif //HYBRID_EVO_ALGORITHM_RESCHEDULE_H
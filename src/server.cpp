@@ -0,0 +1,263 @@
+#include <sstream>
+#include <csignal>
+#include <cstring>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "server.h"
+#include "heuristics.h"
+
+ServerClient::~ServerClient() {
+    if (inFd != STDIN_FILENO) close(inFd);
+    if (outFd != STDOUT_FILENO && outFd != inFd) close(outFd);
+}
+
+bool ServerClient::readLine(string &line) {
+    size_t end;
+    while ((end = buffer.find('\n')) == string::npos) {
+        char chunk[4096];
+        ssize_t count = read(inFd, chunk, sizeof(chunk));
+        if (count <= 0) {
+            if (buffer.empty()) return false;
+            end = buffer.size();
+            buffer.push_back('\n');
+            break;
+        }
+        buffer.append(chunk, count);
+    }
+    line = buffer.substr(0, end);
+    buffer.erase(0, end + 1);
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    return true;
+}
+
+void ServerClient::send(string const &message) {
+    std::lock_guard<std::mutex> lock(sendMutex);
+    size_t written = 0;
+    while (written < message.size()) {
+        ssize_t count = write(outFd, message.data() + written, message.size() - written);
+        if (count <= 0) return;
+        written += count;
+    }
+}
+
+/**
+ * starts the worker threads
+ * @param threads number of workers, 0: all cores
+ */
+SolverServer::SolverServer(unsigned int threads) {
+    // a client which closes its connection must not terminate the server
+    std::signal(SIGPIPE, SIG_IGN);
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned int i = 0; i < threads; i++) workers.emplace_back(&SolverServer::work, this);
+}
+
+SolverServer::~SolverServer() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueCondition.notify_all();
+    for (auto &worker: workers) worker.join();
+}
+
+void SolverServer::serveStream() {
+    serve(std::make_shared<ServerClient>(STDIN_FILENO, STDOUT_FILENO));
+}
+
+/**
+ * accept loop of the unix domain socket, a stale socket file at path is replaced
+ * @param path of the socket
+ * @return false if the socket can not be created, otherwise it does not return
+ */
+bool SolverServer::serveSocket(string const &path) {
+    int server_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server_fd < 0) return false;
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    unlink(path.c_str());
+    if (bind(server_fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0 || listen(server_fd, 64) < 0) {
+        close(server_fd);
+        return false;
+    }
+    while (true) {
+        int client_fd = accept(server_fd, nullptr, nullptr);
+        if (client_fd < 0) continue;
+        std::thread(&SolverServer::serve, this, std::make_shared<ServerClient>(client_fd, client_fd)).detach();
+    }
+}
+
+/**
+ * request loop of one client, see class description for the protocol
+ * @param client
+ */
+void SolverServer::serve(std::shared_ptr<ServerClient> const &client) {
+    string line;
+    while (client->readLine(line)) {
+        std::istringstream request(line);
+        string command;
+        if (!(request >> command)) continue;
+
+        if (command == "instance") {
+            string name;
+            request >> name;
+            auto jobs = std::make_shared<Jobs>();
+            string error;
+            if (name.empty()) {
+                client->send("error instance without a name\n");
+            } else if (!readInstance(*client, *jobs, error)) {
+                client->send("error instance " + name + ": " + error + "\n");
+            } else {
+                int lower_bound = JSSPInstance(*jobs, 0).lowerBound();
+                {
+                    std::lock_guard<std::mutex> lock(instanceMutex);
+                    instances[name] = std::move(jobs);
+                }
+                client->send("loaded " + name + " " + std::to_string(lower_bound) + "\n");
+            }
+        } else if (command == "solve") {
+            SolveRequest solve_request;
+            solve_request.client = client;
+            string name, algorithm;
+            if (!(request >> solve_request.id >> name >> algorithm >> solve_request.seconds) ||
+                (algorithm != "ts" && algorithm != "mem")) {
+                client->send("error usage: solve <id> <name> <ts|mem> <seconds> [lower bound]\n");
+                continue;
+            }
+            solve_request.memetic = algorithm == "mem";
+            request >> solve_request.lowerBound;
+            {
+                std::lock_guard<std::mutex> lock(instanceMutex);
+                auto it = instances.find(name);
+                if (it != instances.end()) solve_request.jobs = it->second;
+            }
+            if (!solve_request.jobs) {
+                client->send("error unknown instance " + name + "\n");
+                continue;
+            }
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                queue.push_back(std::move(solve_request));
+            }
+            queueCondition.notify_one();
+        } else if (command == "drop") {
+            string name;
+            request >> name;
+            {
+                std::lock_guard<std::mutex> lock(instanceMutex);
+                instances.erase(name);
+            }
+            client->send("dropped " + name + "\n");
+        } else if (command == "quit") {
+            break;
+        } else {
+            client->send("error unknown request " + command + "\n");
+        }
+    }
+}
+
+/**
+ * reads an instance in the format of instances/README.md, tabs or spaces
+ * @param client
+ * @param jobs output: operations of each job
+ * @param error output: reason if the instance is malformed
+ * @return false if the instance is malformed
+ */
+bool SolverServer::readInstance(ServerClient &client, Jobs &jobs, string &error) {
+    string line;
+    int job_count = 0, machine_count = 0;
+    if (!client.readLine(line) || !(std::istringstream(line) >> job_count >> machine_count) || job_count <= 0 ||
+        machine_count <= 0) {
+        error = "the first line has to be <#jobs> <#machines>";
+        return false;
+    }
+    jobs.assign(job_count, vector<Operation>());
+    bool valid = true;
+    for (int job = 0; job < job_count; job++) {
+        if (!client.readLine(line)) {
+            error = "missing jobs";
+            return false;
+        }
+        std::istringstream row(line);
+        auto visited = vector<bool>(machine_count, false);
+        int machine, duration;
+        while (row >> machine >> duration) {
+            if (machine < 0 || machine >= machine_count || visited[machine] || duration < 0) break;
+            visited[machine] = true;
+            jobs[job].push_back(Operation{machine, duration, job});
+        }
+        if (static_cast<int>(jobs[job].size()) != machine_count) valid = false;
+    }
+    if (!valid) error = "each job has to contain one operation for each machine";
+    return valid;
+}
+
+/**
+ * worker thread: takes requests until the server stops and the queue is empty
+ */
+void SolverServer::work() {
+    // the warm objects of this worker, by instance
+    std::map<std::shared_ptr<Jobs const>, Workspace> workspaces;
+    while (true) {
+        SolveRequest request;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) return;
+            request = std::move(queue.front());
+            queue.pop_front();
+        }
+        solve(request, workspaces);
+    }
+}
+
+/**
+ * runs the tabu search (from the shifting bottleneck solution) or the memetic algorithm (from Heuristics::population)
+ * and streams the new best solutions to the client
+ * @param request
+ * @param workspaces warm objects of the worker
+ */
+void SolverServer::solve(SolveRequest const &request, std::map<std::shared_ptr<Jobs const>, Workspace> &workspaces) {
+    // instances which are only referenced by the workspaces were dropped or replaced
+    for (auto it = workspaces.begin(); it != workspaces.end();) {
+        it = it->first.use_count() == 1 ? workspaces.erase(it) : std::next(it);
+    }
+    auto &workspace = workspaces[request.jobs];
+    if (!workspace.instance) workspace.instance = std::make_unique<JSSPInstance>(*request.jobs);
+    auto &instance = *workspace.instance;
+
+    auto client = request.client;
+    string id = request.id;
+    auto stream = [client, id](Solution const &solution, double seconds) {
+        std::ostringstream message;
+        message << "improved " << id << " " << solution.makespan << " " << seconds << "\n";
+        client->send(message.str());
+    };
+
+    BMResult result;
+    if (request.memetic) {
+        if (!workspace.memetic) {
+            workspace.memetic = std::make_unique<MemeticAlgorithm>(instance);
+            workspace.memetic->setThreads(1);
+        }
+        workspace.memetic->setImprovementCallback(stream);
+        auto start_solutions = Heuristics::population(instance, 30);
+        result = workspace.memetic->optimizePopulation(request.seconds, start_solutions, request.lowerBound);
+        workspace.memetic->setImprovementCallback();
+    } else {
+        if (!workspace.tabuSearch) workspace.tabuSearch = std::make_unique<TabuSearch>(instance);
+        workspace.tabuSearch->setImprovementCallback(stream);
+        Solution start = Heuristics::shiftingBottleneck(instance);
+        result = workspace.tabuSearch->optimize(start, request.seconds, request.lowerBound);
+        workspace.tabuSearch->setImprovementCallback();
+    }
+
+    std::ostringstream message;
+    message << "solution " << id << " " << result.makespan << " " << result.lowerBound << " " << result.gap << "\n";
+    for (auto const &machine: result.solution) {
+        for (size_t i = 0; i < machine.size(); i++) message << (i > 0 ? " " : "") << machine[i];
+        message << "\n";
+    }
+    client->send(message.str());
+}
@@ -0,0 +1,103 @@
+#ifndef HYBRID_EVO_ALGORITHM_SERVER_H
+#define HYBRID_EVO_ALGORITHM_SERVER_H
+
+#include <map>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <condition_variable>
+#include "jssp.h"
+#include "ts.h"
+#include "mem.h"
+
+/**
+ * one client of the solver server: stdin / stdout or a unix domain socket connection. Reads requests line by line,
+ * answers of all workers are written as whole messages. The connection is closed when the last pending request of the
+ * client is answered
+ */
+class ServerClient {
+public:
+    ServerClient(int in_fd, int out_fd): inFd(in_fd), outFd(out_fd) {};
+    ~ServerClient();
+
+    // next line without the line break, false at the end of the input
+    bool readLine(string &line);
+
+    // write a message (one or more lines), a closed connection is ignored
+    void send(string const &message);
+
+private:
+    int inFd, outFd;
+    string buffer;
+    std::mutex sendMutex;
+};
+
+/**
+ * resident solver for many small requests: instances are parsed once and kept by name, a fixed number of worker
+ * threads keep their TabuSearch / MemeticAlgorithm objects (and own copies of the instances) between requests, so a
+ * request only pays for the search. Requests are text lines, numbers separated by white space:
+ *   instance <name>     followed by the instance in the format of instances/README.md, replaces an instance of the same
+ *                       name. Answer: loaded <name> <lower bound>
+ *   solve <id> <name> <ts|mem> <seconds> [lower bound]
+ *                       queued for the next free worker. Answers: improved <id> <makespan> <seconds> for each new best
+ *                       solution while the search runs, then solution <id> <makespan> <lower bound> <gap>, followed by
+ *                       one line of job numbers per machine
+ *   drop <name>         forget an instance. Answer: dropped <name>
+ *   quit                stop reading, queued requests of the client are still answered
+ * Errors are answered with: error <message>
+ */
+class SolverServer {
+public:
+    // threads: number of worker threads, 0: all cores
+    explicit SolverServer(unsigned int threads = 0);
+    // answers the queued requests and stops the workers
+    ~SolverServer();
+
+    // serve a single client on stdin / stdout until the end of the input
+    void serveStream();
+
+    // accept clients on a unix domain socket, each on its own thread. Returns false if the socket can not be opened
+    bool serveSocket(string const &path);
+
+private:
+    using Jobs = vector<vector<Operation>>;
+
+    struct SolveRequest {
+        std::shared_ptr<ServerClient> client;
+        string id;
+        std::shared_ptr<Jobs const> jobs;
+        bool memetic = false;
+        int seconds = 0;
+        int lowerBound = 0;
+    };
+
+    // warm objects of a worker for one instance, created on the first request
+    struct Workspace {
+        std::unique_ptr<JSSPInstance> instance;
+        std::unique_ptr<TabuSearch> tabuSearch;
+        std::unique_ptr<MemeticAlgorithm> memetic;
+    };
+
+    std::mutex instanceMutex;
+    std::map<string, std::shared_ptr<Jobs const>> instances;
+
+    std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    std::deque<SolveRequest> queue;
+    bool stopping = false;
+    vector<std::thread> workers;
+
+    void serve(std::shared_ptr<ServerClient> const &client);
+
+    // reads the instance lines of an instance request, false (with the reason in error) if it is malformed
+    static bool readInstance(ServerClient &client, Jobs &jobs, string &error);
+
+    void work();
+
+    // run a request on the workspace of its instance, workspaces of dropped instances are freed first
+    void solve(SolveRequest const &request, std::map<std::shared_ptr<Jobs const>, Workspace> &workspaces);
+};
+
+
+#endif //HYBRID_EVO_ALGORITHM_SERVER_H
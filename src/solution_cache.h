@@ -0,0 +1,118 @@
+#ifndef HYBRID_EVO_ALGORITHM_SOLUTION_CACHE_H
+#define HYBRID_EVO_ALGORITHM_SOLUTION_CACHE_H
+
+#include <algorithm>
+#include "jssp.h"
+
+/**
+ * map of solutions (keys) to solutions (values) with a fixed number of entries, indexed by a 64 bit fingerprint of the
+ * key. Cleared when all entries are used. An entry stores its key, so a fingerprint collision is a miss, not a wrong
+ * value. The entries are slots of two flat sequence buffers with an open addressing index (linear probing), the buffers
+ * grow by doubling up to the capacity and keep their storage over clear and reset, so lookups and inserts do not
+ * allocate after warm-up
+ */
+template<typename IndexT, typename TimeT>
+class BasicSolutionCache {
+public:
+    using FlatSolutionT = BasicFlatSolution<IndexT, TimeT>;
+
+    /**
+     * clear the cache and set its size
+     * @param capacity number of entries, 0 disables the cache
+     * @param sequence_size number of operations of the solutions
+     */
+    void reset(int capacity, int sequence_size) {
+        entryCapacity = std::max(capacity, 0);
+        sequenceSize = sequence_size;
+        fingerprints.resize(entryCapacity);
+        makespans.resize(entryCapacity);
+        size_t table_size = 1;
+        while (table_size < 2 * static_cast<size_t>(entryCapacity)) table_size *= 2;
+        table.resize(table_size);
+        mask = table_size - 1;
+        clear();
+    }
+
+    void clear() {
+        std::fill(table.begin(), table.end(), -1);
+        count = 0;
+    }
+
+    [[nodiscard]] int size() const { return count; };
+
+    /**
+     * copy the cached value of a solution into target, which keeps its storage
+     * @param fingerprint fingerprint of key
+     * @param key
+     * @param target
+     * @return false if the solution is not cached
+     */
+    bool find(uint64_t fingerprint, FlatSolutionT const &key, FlatSolutionT &target) const {
+        if (entryCapacity == 0) return false;
+        for (size_t i = fingerprint & mask; table[i] >= 0; i = (i + 1) & mask) {
+            int entry = table[i];
+            if (fingerprints[entry] != fingerprint) continue;
+            size_t offset = static_cast<size_t>(entry) * sequenceSize;
+            // a fingerprint collision
+            if (!std::equal(key.sequence.begin(), key.sequence.end(), keySequences.begin() + offset)) return false;
+            auto begin = sequences.begin() + offset;
+            target.sequence.assign(begin, begin + sequenceSize);
+            target.stride = stride;
+            target.makespan = makespans[entry];
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * cache a copy of the key and the value, replaces the entry of the same fingerprint
+     * @param fingerprint fingerprint of key
+     * @param key
+     * @param solution value
+     */
+    void insert(uint64_t fingerprint, FlatSolutionT const &key, FlatSolutionT const &solution) {
+        if (entryCapacity == 0) return;
+        size_t i = fingerprint & mask;
+        while (table[i] >= 0 && fingerprints[table[i]] != fingerprint) i = (i + 1) & mask;
+        int entry = table[i];
+        if (entry < 0) {
+            if (count >= entryCapacity) {
+                clear();
+                i = fingerprint & mask;
+            }
+            entry = count++;
+            table[i] = entry;
+            fingerprints[entry] = fingerprint;
+            size_t needed = static_cast<size_t>(count) * sequenceSize;
+            if (sequences.size() < needed) {
+                size_t size = std::min(std::max(needed, 2 * sequences.size()),
+                                       static_cast<size_t>(entryCapacity) * sequenceSize);
+                sequences.resize(size);
+                keySequences.resize(size);
+            }
+        }
+        size_t offset = static_cast<size_t>(entry) * sequenceSize;
+        std::copy(key.sequence.begin(), key.sequence.end(), keySequences.begin() + offset);
+        std::copy(solution.sequence.begin(), solution.sequence.end(), sequences.begin() + offset);
+        makespans[entry] = solution.makespan;
+        stride = solution.stride;
+    }
+
+private:
+    int entryCapacity = 0;
+    int sequenceSize = 0;
+    // jobs per machine of the cached solutions
+    int stride = 0;
+    int count = 0;
+    // entry of each index position, -1: empty
+    vector<int> table;
+    size_t mask = 0;
+    vector<uint64_t> fingerprints;
+    vector<TimeT> makespans;
+    // key and value sequence of entry i at [i * sequenceSize, (i + 1) * sequenceSize)
+    vector<IndexT> keySequences;
+    vector<IndexT> sequences;
+};
+
+
+#endif //HYBRID_EVO_ALGORITHM_SOLUTION_CACHE_H
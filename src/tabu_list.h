@@ -5,7 +5,9 @@
 #include "ts.h"
 
 /**
- * internal struct for managing the tabu solutions in tabu search
+ * internal struct for managing the tabu solutions in tabu search, a slot of BasicTabuList
+ * the jobs at [start_index, end_index] of the machine sequence after the move are stored in the sequence buffer of the
+ * tabu list at the slot. id 0: free slot
  */
 struct TabuListItem {
     int tabuTenure;
@@ -13,36 +15,39 @@ struct TabuListItem {
     int id;
     int start_index;
     int end_index;
-    vector<int> sequence;
-    bool operator==(TabuListItem &other) const {
-        return id == other.id;
-    }
-    bool operator==(TabuListItem const &other) const {
-        return id == other.id;
-    }
 };
 
 /**
  * internal class for managing the tabu list in tabu search
- * tabu list contains sequence the block of sequence (with indices) which were deciding for the move
+ * tabu list contains the block of the machine sequence (with indices) which was deciding for the move.
+ * the items live in fixed slots with room for a whole machine sequence each, so updates do not allocate
  */
-class TabuList {
+template<typename IndexT, typename TimeT>
+class BasicTabuList {
 public:
-    explicit TabuList(JSSPInstance &instance):
-            tabuListSize(calcTabuListSize(instance)), tabuList(vector<TabuListItem>()), rng(instance.getSeed()) {};
+    using Neighbour = BasicNeighbour<IndexT, TimeT>;
+
+    explicit BasicTabuList(JSSPInstance &instance): rng(instance.getSeed()), tabuListSize(calcTabuListSize(instance)),
+            blockCapacity(instance.jobCount) {
+        resizeSlots(tabuListSize);
+    };
 
     /**
      * checks the given solution against the tabu list.
      * @param neighbour
+     * @param machine_seq sequence of the neighbours machine in the current solution, before the move
      * @return true if the solution is tabu
      */
-    bool isTabu(Neighbour const &neighbour) {
-        for (auto const &tabu_item: tabuList) {
-            if (neighbour.machine != tabu_item.machine) continue;
+    bool isTabu(Neighbour const &neighbour, IndexT const *machine_seq) {
+        for (size_t slot = 0; slot < tabuList.size(); slot++) {
+            auto const &tabu_item = tabuList[slot];
+            if (tabu_item.id == 0 || neighbour.machine != tabu_item.machine) continue;
+            IndexT const *sequence = sequences.data() + slot * blockCapacity;
             bool isTabu = true;
             for (auto i = tabu_item.start_index; i <= tabu_item.end_index; i++) {
-                if (neighbour.sequence[i] != tabu_item.sequence[i]) {
+                if (neighbour.jobAt(machine_seq, i) != sequence[i - tabu_item.start_index]) {
                     isTabu = false;
+                    break;
                 }
             }
             if (isTabu) return true;
@@ -53,32 +58,42 @@ public:
     /**
      * updates tabu list after a tabu move
      * @param neighbour to prohibit
+     * @param machine_seq sequence of the neighbours machine in the current solution, before the move
      * @param bestMakespan required for tenure calculation
      * (tenure := number iterations the solution stays tabu)
      */
-    void updateTabuList(Neighbour const &neighbour, int bestMakespan) {
-        TabuListItem smallest = TabuListItem{INT32_MAX};
-        int next = 0;
-        while (next < tabuList.size()) {
-            --tabuList[next].tabuTenure;
-            if (tabuList[next].tabuTenure <= 0) {
-                auto item = tabuList[next];
-                tabuList.erase(tabuList.begin() + next);
-                continue;
-            } else if (tabuList[next].tabuTenure < smallest.tabuTenure){
-                smallest = tabuList[next];
+    void updateTabuList(Neighbour const &neighbour, IndexT const *machine_seq, int bestMakespan) {
+        // the item with the smallest tenure, the oldest of equal ones
+        int smallest = -1;
+        int free_slot = -1;
+        for (int slot = 0; slot < static_cast<int>(tabuList.size()); slot++) {
+            auto &item = tabuList[slot];
+            if (item.id != 0 && --item.tabuTenure <= 0) {
+                item.id = 0;
+                --itemCount;
+            }
+            if (item.id == 0) {
+                if (free_slot < 0) free_slot = slot;
+            } else if (smallest < 0 || item.tabuTenure < tabuList[smallest].tabuTenure ||
+                       (item.tabuTenure == tabuList[smallest].tabuTenure && item.id < tabuList[smallest].id)) {
+                smallest = slot;
             }
-            ++next;
         }
-        if (tabuList.size() >= tabuListSize) {
-            auto pos = std::find(tabuList.begin(), tabuList.end(), smallest);
-            tabuList.erase(pos);
+        if (itemCount >= tabuListSize && smallest >= 0) {
+            tabuList[smallest].id = 0;
+            --itemCount;
+            if (free_slot < 0) free_slot = smallest;
         }
-        int tenture_max = std::max((neighbour.makespan - bestMakespan) / d1, d2);
+        int tenture_max = std::max((static_cast<int>(neighbour.makespan) - bestMakespan) / d1, d2);
         std::uniform_int_distribution<std::mt19937::result_type> dist(0,tenture_max);
         int tenure = tt + dist(rng);
 
-        tabuList.emplace_back(TabuListItem{tenure, neighbour.machine, ++tabuId, neighbour.startIndex, neighbour.endIndex, neighbour.sequence});
+        IndexT *sequence = sequences.data() + free_slot * blockCapacity;
+        for (int i = neighbour.startIndex; i <= neighbour.endIndex; i++) {
+            sequence[i - neighbour.startIndex] = neighbour.jobAt(machine_seq, i);
+        }
+        tabuList[free_slot] = TabuListItem{tenure, neighbour.machine, ++tabuId, neighbour.startIndex, neighbour.endIndex};
+        ++itemCount;
     }
 
     /**
@@ -102,7 +117,8 @@ public:
      * reset the tabu list to initial state
      */
     void reset() {
-         tabuList.clear();
+         for (auto &item: tabuList) item.id = 0;
+         itemCount = 0;
          tabuId = 0;
      }
 
@@ -121,14 +137,27 @@ public:
         d1 = _d1;
         d2 = _d2;
         if (_tabuListSize != 0) tabuListSize = _tabuListSize;
+        if (tabuListSize > tabuList.size()) resizeSlots(tabuListSize);
     }
 private:
-    vector<TabuListItem> tabuList;
-    unsigned int tabuListSize;
+    // rng first, calcTabuListSize draws from it
     std::mt19937 rng;
+    unsigned int tabuListSize;
+    // longest block of a move: a whole machine sequence
+    int blockCapacity;
+    // slots of the items, at least tabuListSize. The jobs of the item in slot i are at sequences[i * blockCapacity]
+    vector<TabuListItem> tabuList;
+    vector<IndexT> sequences;
+    unsigned int itemCount = 0;
     int tabuId = 0;
     // constants, see Zhang et al.
     int tt = 2, d1 = 5, d2 = 12;
+
+    // more slots for a larger tabu list, the items keep their slots
+    void resizeSlots(unsigned int slot_count) {
+        tabuList.resize(slot_count, TabuListItem{0, 0, 0, 0, 0});
+        sequences.resize(static_cast<size_t>(slot_count) * blockCapacity);
+    }
 };
 
 
@@ -1,378 +1,560 @@
 #include "ts.h"
 #include <algorithm>
-#include <queue>
+
+/**
+ * select the layout for the instance, see layout.h
+ * @param instance
+ * @param neighbourhood neighbourhood structure, see neighbourhood.h
+ */
+TabuSearch::TabuSearch(JSSPInstance &instance, NeighbourhoodStructure neighbourhood, int time_horizon):
+        engine(selectLayout(instance, [&instance, neighbourhood](auto layout) -> std::unique_ptr<TabuSearchBase> {
+            return makeTabuSearch<decltype(layout)>(instance, neighbourhood);
+        }, time_horizon)) {}
+
+/**
+ * create the tabu search for a layout, specialised to the shape of the instance if possible
+ * @param instance
+ * @param neighbourhood neighbourhood structure, see neighbourhood.h
+ * @return tabu search
+ */
+template<typename L>
+std::unique_ptr<TabuSearchCore<typename L::Index, typename L::Time>> makeTabuSearch(JSSPInstance &instance, NeighbourhoodStructure neighbourhood) {
+    return selectShape<L>(instance, [&instance, neighbourhood](auto layout) -> std::unique_ptr<TabuSearchCore<typename L::Index, typename L::Time>> {
+        using Shaped = decltype(layout);
+        if (neighbourhood == n5) return std::make_unique<TabuSearchEngine<Shaped, N5Neighbourhood>>(instance);
+        if (neighbourhood == n6) return std::make_unique<TabuSearchEngine<Shaped, N6Neighbourhood>>(instance);
+        return std::make_unique<TabuSearchEngine<Shaped, N7Neighbourhood>>(instance);
+    });
+}
+
+template<typename L, typename Neighbourhood>
+TabuSearchEngine<L, Neighbourhood>::TabuSearchEngine(JSSPInstance &instance):
+        instance(instance), tabuList(instance), rng(instance.getSeed()) {
+    if constexpr (fixedOperations == 0) {
+        int op_count = instance.jobCount * instance.machineCount;
+        disjunctiveGraph.resize(op_count);
+        operationIds.resize(op_count);
+        topologicalOrder.resize(op_count);
+        predecessorCount.resize(op_count);
+        longestPath.resize(op_count);
+        lenToI.resize(instance.jobCount);
+        lenFromI.resize(instance.jobCount);
+        jobEnd.resize(instance.jobCount);
+        jobPosition.resize(instance.jobCount);
+        machineEnd.resize(instance.machineCount);
+        machinePosition.resize(instance.machineCount);
+        relinkSegment.resize(instance.jobCount);
+        relinkLow.resize(instance.machineCount);
+        relinkHigh.resize(instance.machineCount);
+    }
+    archive.setParams(10, std::max(3, instance.operationCount() / 20));
+    // fixed seed: the keys must not consume numbers of the instance rng
+    std::mt19937_64 key_rng(0x9e3779b97f4a7c15);
+    zobristKeys.resize(static_cast<size_t>(instance.machineCount) * instance.jobCount * instance.jobCount);
+    for (auto &key: zobristKeys) key = key_rng();
+}
 
 /**
  * internal function for logging the makespan
  * @param makespan
  */
-void TabuSearch::logMakespan(int makespan) {
+template<typename L, typename Neighbourhood>
+void TabuSearchEngine<L, Neighbourhood>::logMakespan(int makespan) {
     std::chrono::duration<double> elapsed_seconds = (std::chrono::system_clock::now() - startTime);
     makespanHistory.emplace_back(std::tuple{elapsed_seconds.count(), makespan});
+    if (improvementCallback) improvementCallback(bestSolution.toSolution(), elapsed_seconds.count());
 }
 
 /**
- * iteration constrained tabu search
+ * iteration constrained tabu search on the flat solution representation
  * @param solution starting solution
  * @param max_iterations
- * @return solution struct: tabular solution, makespan
+ * @param max_stagnation stop after this many iterations without a new best solution, 0 for no limit
+ * @return best solution found, valid until the next call
  */
-Solution TabuSearch::optimize_it(Solution &solution, long max_iterations) {
-    tabuList.reset();
+template<typename L, typename Neighbourhood>
+typename TabuSearchEngine<L, Neighbourhood>::FlatSolutionT const &TabuSearchEngine<L, Neighbourhood>::optimize_it(FlatSolutionT const &solution, long max_iterations, long max_stagnation) {
+    if (!keepTabuList) tabuList.reset();
     currentSolution = solution;
-    bestSolution = solution;
-    disjunctiveGraph = generateDisjunctiveGraph();
+    generateDisjunctiveGraph();
+    bestSolution = currentSolution;
+    resetVisits();
     long iteration = 0;
+    lastImprovementIteration = 0;
 
     while (iteration++ <= max_iterations) {
-        auto neighbourhood = generateNeighbourhood();
-        tsMove(neighbourhood);
+        iterate();
         if (currentSolution.makespan < bestSolution.makespan) {
             bestSolution = currentSolution;
+            lastImprovementIteration = iteration;
+        } else if (max_stagnation > 0 && iteration - lastImprovementIteration >= max_stagnation) {
+            break;
         }
     }
     return bestSolution;
 }
 
 /**
- * time constrained tabu search
+ * time constrained tabu search, a run of start, step and finish
  * @param solution starting solution
  * @param seconds maximum runtime, soft limit
- * @param lower_bound best known solution / lower bound for early stop when found
- * @return BMResult struct: solution, makespan, history (solution - time log)
+ * @param lower_bound best known solution / lower bound for early stop when found, see also setTargetGap
+ * @return BMResult struct: solution, makespan, history (solution - time log), lower bound and gap
+ */
+template<typename L, typename Neighbourhood>
+BMResult TabuSearchEngine<L, Neighbourhood>::optimize(FlatSolutionT const &solution, int seconds, int lower_bound) {
+    start(solution, lower_bound);
+    if (seconds > 0) step(0, seconds);
+    return finish();
+}
+
+/**
+ * starts a resumable run on a solution, see step
+ * @param solution starting solution
+ * @param lower_bound best known solution / lower bound for early stop when found, see also setTargetGap
  */
-BMResult TabuSearch::optimize(Solution &solution, int seconds, int lower_bound) {
+template<typename L, typename Neighbourhood>
+void TabuSearchEngine<L, Neighbourhood>::start(FlatSolutionT const &solution, int lower_bound) {
     startTime = std::chrono::system_clock::now();
     makespanHistory = vector<std::tuple<double,int>>();
 
-    tabuList.reset();
+    if (!keepTabuList) tabuList.reset();
     currentSolution = solution;
-    bestSolution = solution;
-    disjunctiveGraph = generateDisjunctiveGraph();
+    generateDisjunctiveGraph();
+    bestSolution = currentSolution;
+    resetVisits();
+    archive.clear();
+    archive.insert(bestSolution);
     logMakespan(bestSolution.makespan);
 
-    auto elapsed_seconds = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now() - startTime);
-    // main loop
-    while (elapsed_seconds.count() < seconds && lower_bound != bestSolution.makespan) {
-        auto neighbourhood = generateNeighbourhood();
-        tsMove(neighbourhood);
+    runStagnation = 0;
+    runDiversifications = 0;
+    runStopMakespan = instance.stopMakespan(lower_bound, targetGap);
+}
+
+/**
+ * continues the run of start, with the diversification of stagnating searches
+ * @param max_iterations iterations of this step, 0: no limit
+ * @param seconds runtime of this step, soft limit, 0: no limit
+ * @return false if the run reached its lower bound and can not improve anymore
+ */
+template<typename L, typename Neighbourhood>
+bool TabuSearchEngine<L, Neighbourhood>::step(long max_iterations, double seconds) {
+    auto step_start = std::chrono::system_clock::now();
+    std::chrono::duration<double> elapsed_seconds{0};
+    for (long iteration = 0; (max_iterations == 0 || iteration < max_iterations) &&
+                             (seconds == 0 || elapsed_seconds.count() < seconds) &&
+                             bestSolution.makespan > runStopMakespan; iteration++) {
+        iterate();
         if (currentSolution.makespan < bestSolution.makespan) {
             bestSolution = currentSolution;
+            archive.insert(bestSolution);
             logMakespan(bestSolution.makespan);
+            runStagnation = 0;
+            runDiversifications = 0;
+        } else if (stagnationIterations > 0 && ++runStagnation >= stagnationIterations) {
+            ++runDiversifications;
+            diversify(restartInterval > 0 && runDiversifications % restartInterval == 0);
+            runStagnation = 0;
         }
-        elapsed_seconds = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now() - startTime);
+        if (seconds > 0) elapsed_seconds = std::chrono::system_clock::now() - step_start;
     }
-    return BMResult{bestSolution.solution, bestSolution.makespan, makespanHistory};
+    return bestSolution.makespan > runStopMakespan;
+}
+
+/**
+ * result of the run of start and step
+ * @return BMResult struct: solution, makespan, history (solution - time log), lower bound and gap
+ */
+template<typename L, typename Neighbourhood>
+BMResult TabuSearchEngine<L, Neighbourhood>::finish() {
+    return BMResult{bestSolution.toNested(), bestSolution.makespan, makespanHistory, instance.lowerBound(),
+                    relativeGap(bestSolution.makespan, instance.lowerBound())};
 }
 
 /**
- * create a N7 neighbourhood with approximated makespans for current solution
- * @return neighbourhood
+ * long term diversification of optimize, when the search stagnates: perturbationMoves random moves in the
+ * neighbourhood, regardless of the tabu list. With restart the walk starts from a random elite solution instead of the
+ * current solution
+ * @param restart restart from the elite archive
  */
-vector<Neighbour> TabuSearch::generateNeighbourhood() {
-    calcLongestPaths(disjunctiveGraph);
-    auto longest_path = findLongestPath(disjunctiveGraph);
-    auto block_list = generateBlockList(longest_path);
-
-    auto neighbourhood = vector<Neighbour>();
-    for (auto const &block: block_list) {
-        for (auto const &neighbour: generateNeighboursFromBlock(block))
-            neighbourhood.emplace_back(neighbour);
+template<typename L, typename Neighbourhood>
+void TabuSearchEngine<L, Neighbourhood>::diversify(bool restart) {
+    if (restart && !archive.empty()) {
+        std::uniform_int_distribution<int> dist(0, archive.size() - 1);
+        currentSolution = archive[dist(rng)];
+        generateDisjunctiveGraph();
+        tabuList.reset();
+        ++searchStatistics.restarts;
+    } else {
+        ++searchStatistics.perturbations;
+    }
+    resetVisits();
+    for (int i = 0; i < perturbationMoves; i++) {
+        generateNeighbourhood();
+        if (neighbourhood.empty()) break;
+        randomMove();
     }
-    return neighbourhood;
 }
 
 /**
- * sets len_to_n for each node in the disjunctive graph.
- * they are used to find the longest path, create a feasible N7 neighbourhood and approximate the makespan of each
- * neighbour. See Zhang et al. for details, linked in README.md
- * @param d_graph the disjunctive graph
+ * path relinking: walks from the initiating towards the guiding solution. Each step moves a job of one machine to its
+ * position in the guiding solution with an N7 move: at the first differing position of each machine the job of the
+ * guiding solution moves backward into it, at the last differing position forward. The candidate moves are evaluated
+ * with the makespan approximation on the disjunctive graph, the best feasible move is taken.
+ * the result is the best solution of the path between three quarters and a quarter of the initial distance, so it has
+ * features of both solutions. It is meant to be optimized with the tabu search, see MemeticEngine
+ * @param initiating start of the path
+ * @param guiding end of the path
+ * @param result output: selected solution of the path, with exact makespan
  */
-void TabuSearch::calcLongestPaths(vector<vector<std::shared_ptr<Node>>> &d_graph) const {
-    auto end_nodes = vector<std::shared_ptr<Node>>();
-    for (auto &job: d_graph) {
-        if (job.back()->machSuccessor == nullptr) {
-            end_nodes.emplace_back(job.back());
+template<typename L, typename Neighbourhood>
+void TabuSearchEngine<L, Neighbourhood>::relink(FlatSolutionT const &initiating, FlatSolutionT const &guiding, FlatSolutionT &result) {
+    currentSolution = initiating;
+    generateDisjunctiveGraph();
+    int start_distance = sequenceDistance(currentSolution, guiding);
+    int distance = start_distance;
+    bool selected = false;
+    // differing positions of each machine are in [low, high], outside of it the sequences are already equal
+    auto &low = relinkLow;
+    auto &high = relinkHigh;
+    std::fill(low.begin(), low.begin() + machineCount(), 0);
+    std::fill(high.begin(), high.begin() + machineCount(), jobCount() - 1);
+
+    while (distance > start_distance / 4) {
+        Neighbour best_move{};
+        Neighbour move{};
+        bool found = false;
+        for (int machine = 0; machine < machineCount(); machine++) {
+            IndexT const *machine_seq = currentSolution.machine(machine);
+            IndexT const *guiding_seq = guiding.machine(machine);
+            while (low[machine] <= high[machine] && machine_seq[low[machine]] == guiding_seq[low[machine]]) ++low[machine];
+            while (high[machine] >= low[machine] && machine_seq[high[machine]] == guiding_seq[high[machine]]) --high[machine];
+            if (low[machine] > high[machine]) continue;
+
+            int first = low[machine];
+            int last = high[machine];
+            int to_first = static_cast<int>(std::find(machine_seq + first, machine_seq + last + 1, guiding_seq[first]) - machine_seq);
+            if (relinkMove(machine, first, to_first, backward, move) && (!found || move.makespan < best_move.makespan)) {
+                best_move = move;
+                found = true;
+            }
+            int to_last = static_cast<int>(std::find(machine_seq + first, machine_seq + last + 1, guiding_seq[last]) - machine_seq);
+            if (relinkMove(machine, to_last, last, forward, move) && (!found || move.makespan < best_move.makespan)) {
+                best_move = move;
+                found = true;
+            }
+        }
+        if (!found) break;
+
+        IndexT const *machine_seq = currentSolution.machine(best_move.machine);
+        IndexT const *guiding_seq = guiding.machine(best_move.machine);
+        for (int i = best_move.startIndex; i <= best_move.endIndex; i++) distance -= machine_seq[i] != guiding_seq[i];
+        updateCurrentSolution(best_move);
+        for (int i = best_move.startIndex; i <= best_move.endIndex; i++) distance += machine_seq[i] != guiding_seq[i];
+
+        if (distance <= 3 * start_distance / 4 && (!selected || currentSolution.makespan < result.makespan)) {
+            result = currentSolution;
+            selected = true;
         }
     }
-    std::sort(end_nodes.begin(), end_nodes.end(), compNodesByEndTime);
+    if (!selected) result = currentSolution;
+}
 
-    for (auto &node: end_nodes) {
-        recursiveLongestPathCalculation(node);
+/**
+ * move for path relinking, the first operation of the segment moves behind the last (forward) or the last before the
+ * first (backward). Uses the feasibility checks and makespan approximation of the neighbourhood
+ * @param machine
+ * @param start_index first position of the segment in the machine sequence
+ * @param end_index last position of the segment
+ * @param direction forward or backward
+ * @param move output: the move with approximated makespan
+ * @return false if the move is not known to be feasible or the segment is empty
+ */
+template<typename L, typename Neighbourhood>
+bool TabuSearchEngine<L, Neighbourhood>::relinkMove(int machine, int start_index, int end_index, SwapDirection direction, Neighbour &move) {
+    int size = end_index - start_index + 1;
+    if (size < 2 || !isMovable(machine, start_index)) return false;
+    IndexT const *machine_seq = currentSolution.machine(machine);
+    for (int i = 0; i < size; i++) {
+        relinkSegment[i] = operationIds[machine_seq[start_index + i] * machineCount() + machine];
+    }
+    if (direction == forward) {
+        if (!checkForwardSwap(relinkSegment[0], relinkSegment[size - 1])) return false;
+        move = forwardSwap(start_index, 0, size - 1, machine, relinkSegment.data());
+    } else {
+        if (!checkBackwardSwap(relinkSegment[0], relinkSegment[size - 1])) return false;
+        move = backwardSwap(start_index, 0, size - 1, machine, relinkSegment.data());
     }
+    return true;
 }
 
 /**
- * recursive function for the len_to_n calculation. see TabuSearch::calcLongestPaths
- * recursive calculation is started at the node with the largest starting time, so each node is visited only once.
- * @param node the current node
+ * one iteration of the search: a tabu move, or a random move while escaping from a cycle
  */
-void TabuSearch::recursiveLongestPathCalculation(std::shared_ptr<Node> const &node) const {
-    if (!node->machPredecessor.expired()) {
-        auto mp = node->machPredecessor.lock();
-        if (mp->lenToN < node->lenToN + node->duration) {
-            mp->lenToN = node->lenToN + node->duration;
-            recursiveLongestPathCalculation(mp);
-        }
+template<typename L, typename Neighbourhood>
+void TabuSearchEngine<L, Neighbourhood>::iterate() {
+    generateNeighbourhood();
+    if (pendingEscapeMoves > 0 && !neighbourhood.empty()) {
+        --pendingEscapeMoves;
+        randomMove();
+    } else {
+        tsMove();
     }
-    if (!node->jobPredecessor.expired()) {
-        auto jp = node->jobPredecessor.lock();
-        if (jp->lenToN < node->lenToN + node->duration) {
-            jp->lenToN = node->lenToN + node->duration;
-            recursiveLongestPathCalculation(jp);
+    recordVisit();
+}
+
+/**
+ * zobrist hash of the machine sequences: xor of the keys of each (machine, position, job)
+ * @param solution
+ * @return hash
+ */
+template<typename L, typename Neighbourhood>
+uint64_t TabuSearchEngine<L, Neighbourhood>::calcHash(FlatSolutionT const &solution) const {
+    uint64_t hash = 0;
+    for (int machine = 0; machine < machineCount(); machine++) {
+        for (int i = 0; i < jobCount(); i++) {
+            hash ^= zobristKeys[(machine * jobCount() + i) * jobCount() + solution.machine(machine)[i]];
         }
     }
+    return hash;
+}
 
+/**
+ * clear the cycle detection window, called at the start of each search
+ */
+template<typename L, typename Neighbourhood>
+void TabuSearchEngine<L, Neighbourhood>::resetVisits() {
+    visitWindow.assign(cycleWindow, 0);
+    size_t bucket_count = 1;
+    while (bucket_count < 4 * static_cast<size_t>(cycleWindow)) bucket_count *= 2;
+    visitBuckets.assign(bucket_count, 0);
+    visitCount = 0;
+    visitPosition = 0;
+    pendingEscapeMoves = 0;
 }
 
 /**
- * use len_to_n of the disjunctive graph to find a longest path in the instance
- * @param d_graph the disjunctive graph
- * @return a longest path of the disjunctive graph
+ * cycle detection: a revisit is a current solution which was already current within the last cycleWindow
+ * iterations. The tabu list only forbids block features, so the search can run in cycles without it. A revisit starts
+ * an escape of escapeMoves random moves, unless an escape is already running
  */
-vector<std::shared_ptr<Node>> TabuSearch::findLongestPath(const vector<vector<std::shared_ptr<Node>>>& d_graph) const {
-    std::shared_ptr<Node> start_node;
-    for (auto const &job: d_graph) {
-        if (job.front()->lenToN + job.front()->duration == currentSolution.makespan) {
-            start_node = job.front();
+template<typename L, typename Neighbourhood>
+void TabuSearchEngine<L, Neighbourhood>::recordVisit() {
+    ++searchStatistics.iterations;
+    if (cycleWindow == 0) return;
+    size_t mask = visitBuckets.size() - 1;
+    if (visitBuckets[currentHash & mask] > 0
+        && std::find(visitWindow.begin(), visitWindow.begin() + visitCount, currentHash) != visitWindow.begin() + visitCount) {
+        ++searchStatistics.revisits;
+        if (pendingEscapeMoves == 0 && escapeMoves > 0) {
+            pendingEscapeMoves = escapeMoves;
+            ++searchStatistics.escapes;
         }
     }
-    vector<std::shared_ptr<Node>> longest_path = {start_node};
-    while (longest_path.back()->lenToN != 0) {
-        if (longest_path.back()->machSuccessor) {
-            auto len = longest_path.back()->machSuccessor->lenToN + longest_path.back()->machSuccessor->duration;
-            if (len == longest_path.back()->lenToN) {
-                longest_path.emplace_back(longest_path.back()->machSuccessor);
-                continue;
-            }
-        }
-        if (longest_path.back()->jobSuccessor) {
-            auto len = longest_path.back()->jobSuccessor->lenToN + longest_path.back()->jobSuccessor->duration;
-            if (len == longest_path.back()->lenToN) {
-                longest_path.emplace_back(longest_path.back()->jobSuccessor);
-                continue;
-            }
-        }
+    if (visitCount == cycleWindow) {
+        --visitBuckets[visitWindow[visitPosition] & mask];
+    } else {
+        ++visitCount;
     }
-    return longest_path;
+    visitWindow[visitPosition] = currentHash;
+    ++visitBuckets[currentHash & mask];
+    visitPosition = (visitPosition + 1) % cycleWindow;
 }
 
 /**
- * generate neighbourhood blocks of the longest path, to create a neighbourhood from it.
- * block: operations of the longest path, which are consecutive on the same machine
- * @param longest_path see TabuSearch::findLongestPath
- * @return vector of blocks
+ * create the neighbourhood with approximated makespans for current solution, written to neighbourhood
  */
-vector<vector<std::shared_ptr<Node>>> TabuSearch::generateBlockList(vector<std::shared_ptr<Node>> const &longest_path) {
-    auto block_list = vector<vector<std::shared_ptr<Node>>>();
-    auto block = vector<std::shared_ptr<Node>>();
-    for (auto const &node: longest_path) {
-        if (block.empty() || node->machine == block.back()->machine) {
-            block.emplace_back(node);
-        } else if (block.size() > 1){
-            block_list.emplace_back(block);
-            block.clear();
-            block.emplace_back(node);
-        } else {
-            block.clear();
-            block.emplace_back(node);
-        }
+template<typename L, typename Neighbourhood>
+void TabuSearchEngine<L, Neighbourhood>::generateNeighbourhood() {
+    findLongestPath();
+    generateBlockList();
+
+    neighbourhood.clear();
+    for (auto const &block: blockList) {
+        generateNeighboursFromBlock(longestPath.data() + block.first, block.second - block.first,
+                                    block.first == 0, block.second == longestPathLength);
     }
-    if (block.size() > 1) block_list.emplace_back(block);
-    return block_list;
 }
 
 /**
- * test if N7 swap results in a feasible solution, add machine sequence as neighbour and approximate makespan
- * @param block see TabuSearch::generateBlockList
- * @return a list of legal neighbours with approximated makespans
+ * sets start and len_to_n for each node in the disjunctive graph and the makespan of the current solution.
+ * they are used to find the longest path, create a feasible N7 neighbourhood and approximate the makespan of each
+ * neighbour. See Zhang et al. for details, linked in README.md
+ * see calcHeadsAndTails
  */
-vector<Neighbour> TabuSearch::generateNeighboursFromBlock(vector<std::shared_ptr<Node>> const &block) const {
-    auto neighbours = vector<Neighbour>();
-    int machine_no = block.front()->machine;
-    auto const &machine_seq = currentSolution.solution[machine_no];
-    int start_index = static_cast<int>(std::find(machine_seq.begin(), machine_seq.end(), block.front()->job) - machine_seq.begin());
-
-    if (block.size() == 2) {
-        neighbours.emplace_back(forwardSwap(machine_seq, start_index, 0, 1, machine_no, block));
-    } else {
-        for (int u = 1; u < block.size() - 1; u++) {
-            // move middle operations behind the last
-            if (checkForwardSwap(block[u], block.back())) {
-                neighbours.emplace_back(forwardSwap(machine_seq, start_index, u, static_cast<int>(block.size() - 1), machine_no, block));
+template<typename L, typename Neighbourhood>
+void TabuSearchEngine<L, Neighbourhood>::calcLongestPaths() {
+    int makespan = calcHeadsAndTails(disjunctiveGraph.data(), jobCount() * machineCount(), nil, topologicalOrder.data(),
+                                     predecessorCount.data(), releaseTimes.empty() ? nullptr : releaseTimes.data());
+    if (makespan < 0) {
+        std::cout << "Error in solution detected. Terminating..." << std::endl;
+        exit(1);
+    }
+    currentSolution.makespan = static_cast<TimeT>(makespan);
+}
+
+/**
+ * use len_to_n of the disjunctive graph to find a longest path in the instance, written to longestPath.
+ * without release times it starts at the first operation of a job, with them at an operation which starts at its
+ * release time
+ */
+template<typename L, typename Neighbourhood>
+void TabuSearchEngine<L, Neighbourhood>::findLongestPath() {
+    IndexT start_node = nil;
+    if (releaseTimes.empty()) {
+        for (int job = 0; job < jobCount(); job++) {
+            IndexT first = job * machineCount();
+            if (tailLength(first) == currentSolution.makespan) {
+                start_node = first;
             }
         }
-        for (int v = 1; v < block.size(); v++) {
-            // move first operation behind every operation
-            if (checkForwardSwap(block.front(), block[v])) {
-                neighbours.emplace_back(forwardSwap(machine_seq, start_index, 0, v, machine_no, block));
+    } else {
+        for (int op = 0; op < jobCount() * machineCount(); op++) {
+            auto const &node = disjunctiveGraph[op];
+            if (node.start == releaseTimes[op] && node.start + tailLength(op) == currentSolution.makespan) {
+                start_node = static_cast<IndexT>(op);
             }
         }
-        for (int v = 1; v < block.size() - 1; v++) {
-            // move middle operations before first
-            if (checkBackwardSwap(block.front(), block[v])) {
-                neighbours.emplace_back(backwardSwap(machine_seq, start_index, 0, v, machine_no, block));
-            }
+    }
+    longestPathLength = 0;
+    longestPath[longestPathLength++] = start_node;
+    while (disjunctiveGraph[longestPath[longestPathLength - 1]].lenToN != 0) {
+        auto const &node = disjunctiveGraph[longestPath[longestPathLength - 1]];
+        if (node.machSuccessor != nil && tailLength(node.machSuccessor) == node.lenToN) {
+            longestPath[longestPathLength++] = node.machSuccessor;
+            continue;
         }
-        for (int u = 0; u < block.size() - 1; u++) {
-            // move last operation before every operation
-            if (checkBackwardSwap(block[u], block.back())) {
-                neighbours.emplace_back(backwardSwap(machine_seq, start_index, u, static_cast<int>(block.size() - 1), machine_no, block));
-            }
+        if (node.jobSuccessor != nil && tailLength(node.jobSuccessor) == node.lenToN) {
+            longestPath[longestPathLength++] = node.jobSuccessor;
+            continue;
         }
     }
-    return neighbours;
+}
+
+/**
+ * generate neighbourhood blocks of the longest path, to create a neighbourhood from it.
+ * block: operations of the longest path, which are consecutive on the same machine
+ */
+template<typename L, typename Neighbourhood>
+void TabuSearchEngine<L, Neighbourhood>::generateBlockList() {
+    blockList.clear();
+    int begin = 0;
+    for (int i = 1; i <= longestPathLength; i++) {
+        if (i < longestPathLength && disjunctiveGraph[longestPath[i]].machine == disjunctiveGraph[longestPath[begin]].machine) {
+            continue;
+        }
+        if (i - begin > 1) blockList.emplace_back(begin, i);
+        begin = i;
+    }
+}
+
+/**
+ * add the moves of the neighbourhood policy inside a block to the neighbourhood, with approximated makespans
+ * @param block operation ids of the block, see TabuSearchEngine::generateBlockList
+ * @param block_size
+ * @param path_start if the block starts the longest path
+ * @param path_end if the block ends the longest path
+ */
+template<typename L, typename Neighbourhood>
+void TabuSearchEngine<L, Neighbourhood>::generateNeighboursFromBlock(IndexT const *block, int block_size, bool path_start, bool path_end) {
+    int machine_no = disjunctiveGraph[block[0]].machine;
+    IndexT const *machine_seq = currentSolution.machine(machine_no);
+    int start_index = static_cast<int>(std::find(machine_seq, machine_seq + currentSolution.stride, disjunctiveGraph[block[0]].job) - machine_seq);
+
+    auto moves = BlockMoves{*this, block, start_index, machine_no};
+    Neighbourhood::generate(moves, block_size, path_start, path_end);
 }
 
 /**
  * swap operation from u to v in the block and approximate makespan
  * for details see E. Balas and A. Vazacopoulos, linked in README.md
- * @param sequence machine sequence in current solution
- * @param start_index of the block
+ * @param start_index of the block in the machine sequence
  * @param u operation to swap
  * @param v target position
  * @param machine
- * @param block
+ * @param block operation ids of the block
  * @return Neighbour with approximated makespan
  */
-Neighbour TabuSearch::forwardSwap(vector<int> sequence, int const start_index, int const u, int const v, int const machine, vector<std::shared_ptr<Node>> const &block) {
-    int item_u = sequence[start_index + u];
-    sequence.erase(sequence.begin() + start_index + u);
-    sequence.emplace(sequence.begin() + start_index + v, item_u);
-
+template<typename L, typename Neighbourhood>
+typename TabuSearchEngine<L, Neighbourhood>::Neighbour TabuSearchEngine<L, Neighbourhood>::forwardSwap(int const start_index, int const u, int const v, int const machine, IndexT const *block) {
+    auto const &graph = disjunctiveGraph;
     const int size = v - u + 1;
-    auto len_to_i = vector<int>(size);
-    auto len_from_i = vector<int>(size);
+    auto &len_to_i = lenToI;
+    auto &len_from_i = lenFromI;
 
-    {
-        int jp_1 = 0;
-        if (!block[u + 1]->jobPredecessor.expired()) {
-            auto jp = block[u + 1]->jobPredecessor.lock();
-            jp_1 = jp->start + jp->duration;
-        }
-        int mp_u = 0;
-        if (!block[u]->machPredecessor.expired()) {
-            auto mp = block[u]->machPredecessor.lock();
-            mp_u = mp->start + mp->duration;
-        }
-        len_to_i[1] = std::max(jp_1, mp_u);
-    }
+    len_to_i[1] = std::max(endTime(graph[block[u + 1]].jobPredecessor), endTime(graph[block[u]].machPredecessor));
     for (int w = 2; w < size; w++) {
-        int jp_w = 0;
-        if (!block[w]->jobPredecessor.expired()) {
-            auto jp = block[w]->jobPredecessor.lock();
-            jp_w = jp->start + jp->duration;
-        }
-        int y_mp = len_to_i[w - 1] + block[w - 1]->duration;
+        int jp_w = endTime(graph[block[w]].jobPredecessor);
+        int y_mp = len_to_i[w - 1] + graph[block[w - 1]].duration;
         len_to_i[w] = std::max(jp_w, y_mp);
     }
-    {
-        int jp_u = 0;
-        if (!block[u]->jobPredecessor.expired()) {
-            auto jp = block[u]->jobPredecessor.lock();
-            jp_u = jp->start + jp->duration;
-        }
-        int y_v = len_to_i.back() + block[v]->duration;
-        len_to_i[0] = std::max(jp_u, y_v);
-    }
+    len_to_i[0] = std::max(endTime(graph[block[u]].jobPredecessor), len_to_i[size - 1] + graph[block[v]].duration);
 
-    {
-        int js_u = !block[u]->jobSuccessor ? 0 : block[u]->jobSuccessor->lenToN + block[u]->jobSuccessor->duration;
-        int ms_v = !block[v]->machSuccessor ? 0 : block[v]->machSuccessor->lenToN + block[v]->machSuccessor->duration;
-        len_from_i[0] = std::max(js_u, ms_v) + block[u]->duration;
-    }
-    {
-        int js_v = !block[v]->jobSuccessor ? 0 : block[v]->jobSuccessor->lenToN + block[v]->jobSuccessor->duration;
-        int y_u = len_from_i[0];
-        len_from_i.back() = std::max(js_v, y_u) + block[v]->duration;
-    }
+    len_from_i[0] = std::max(tailLength(graph[block[u]].jobSuccessor), tailLength(graph[block[v]].machSuccessor)) + graph[block[u]].duration;
+    len_from_i[size - 1] = std::max(tailLength(graph[block[v]].jobSuccessor), len_from_i[0]) + graph[block[v]].duration;
     for (int w = size - 2; w > 0; w--) {
-        int js_w = !block[w]->jobSuccessor ? 0 : block[w]->jobSuccessor->lenToN + block[w]->jobSuccessor->duration;
+        int js_w = tailLength(graph[block[w]].jobSuccessor);
         int ms_w = len_from_i[w + 1];
-        len_from_i[w] = std::max(js_w, ms_w) + block[w]->duration;
+        len_from_i[w] = std::max(js_w, ms_w) + graph[block[w]].duration;
     }
 
     int approx_makespan = 0;
     for (int i = 0; i < size; i++) {
         approx_makespan = std::max(approx_makespan, len_to_i[i] + len_from_i[i]);
     }
+    approx_makespan = std::min<int>(approx_makespan, std::numeric_limits<TimeT>::max());
 
     SwapDirection swap_direction = (v - u == 1) ? adjacent : forward;
-    return {sequence, machine, approx_makespan, start_index + u, start_index+ v, swap_direction};
+    return {static_cast<TimeT>(approx_makespan), static_cast<IndexT>(machine), static_cast<IndexT>(start_index + u),
+            static_cast<IndexT>(start_index + v), swap_direction};
 }
 
 /**
  * swap operation from v to u in the block and approximate makespan
  * for details see E. Balas and A. Vazacopoulos, linked in README.md
- * @param sequence machine sequence in current solution
- * @param start_index of the block
+ * @param start_index of the block in the machine sequence
  * @param u target position
  * @param v operation to swap
  * @param machine
- * @param block
+ * @param block operation ids of the block
  * @return Neighbour with approximated makespan
  */
-Neighbour TabuSearch::backwardSwap(vector<int> sequence, int const start_index, int const u, int const v, int const machine, vector<std::shared_ptr<Node>> const &block) {
-    int v_item = sequence[start_index + v];
-    sequence.erase(sequence.begin() + start_index + v);
-    sequence.emplace(sequence.begin() + start_index + u, v_item);
-
+template<typename L, typename Neighbourhood>
+typename TabuSearchEngine<L, Neighbourhood>::Neighbour TabuSearchEngine<L, Neighbourhood>::backwardSwap(int const start_index, int const u, int const v, int const machine, IndexT const *block) {
+    auto const &graph = disjunctiveGraph;
     const int size = v - u + 1;
-    auto len_to_i = vector<int>(size);
-    auto len_from_i = vector<int>(size);
+    auto &len_to_i = lenToI;
+    auto &len_from_i = lenFromI;
 
-    {
-        int jp_v = 0;
-        if (!block[v]->jobPredecessor.expired()) {
-            auto jp = block[v]->jobPredecessor.lock();
-            jp_v = jp->start + jp->duration;
-        }
-        int mp_u = 0;
-        if (!block[u]->machPredecessor.expired()) {
-            auto mp = block[u]->machPredecessor.lock();
-            mp_u = mp->start + mp->duration;
-        }
-        len_to_i.back() = std::max(jp_v, mp_u);
-    }
-    {
-        int jp_u = 0;
-        if (!block[u]->jobPredecessor.expired()) {
-            auto jp = block[u]->jobPredecessor.lock();
-            jp_u = jp->start + jp->duration;
-        }
-        int y_v = len_to_i.back() + block[v]->duration;
-        len_to_i[0] = std::max(jp_u, y_v);
-    }
+    len_to_i[size - 1] = std::max(endTime(graph[block[v]].jobPredecessor), endTime(graph[block[u]].machPredecessor));
+    len_to_i[0] = std::max(endTime(graph[block[u]].jobPredecessor), len_to_i[size - 1] + graph[block[v]].duration);
     for (int w = 1; w < size - 1; w++) {
-        int jp_w = block[w]->start + block[w]->duration;
-        int y_mp = len_to_i[w - 1] + block[w - 1]->duration;
+        int jp_w = endTime(block[w]);
+        int y_mp = len_to_i[w - 1] + graph[block[w - 1]].duration;
         len_to_i[w] = std::max(jp_w, y_mp);
     }
 
     {
         int l = size - 2;
-        int js_l = !block[l]->jobSuccessor ? 0 : block[l]->jobSuccessor->lenToN + block[l]->jobSuccessor->duration;
-        int ms_v = !block[v]->machSuccessor ? 0 : block[v]->machSuccessor->lenToN + block[v]->machSuccessor->duration;
-        len_from_i[l] = std::max(js_l, ms_v) + block[l]->duration;
+        len_from_i[l] = std::max(tailLength(graph[block[l]].jobSuccessor), tailLength(graph[block[v]].machSuccessor)) + graph[block[l]].duration;
     }
     for (int w = size - 3; w >= 0; w--) {
-        int js_w = !block[w]->jobSuccessor ? 0 : block[w]->jobSuccessor->lenToN + block[w]->jobSuccessor->duration;
+        int js_w = tailLength(graph[block[w]].jobSuccessor);
         int y_ms = len_from_i[w + 1];
-        len_from_i[w] = std::max(js_w, y_ms) + block[w]->duration;
-    }
-    {
-        int js_v = !block[v]->jobSuccessor ? 0 : block[v]->jobSuccessor->lenToN + block[v]->jobSuccessor->duration;
-        int y_u = len_from_i[0];
-        len_from_i.back() = std::max(js_v, y_u) + block[v]->duration;
+        len_from_i[w] = std::max(js_w, y_ms) + graph[block[w]].duration;
     }
+    len_from_i[size - 1] = std::max(tailLength(graph[block[v]].jobSuccessor), len_from_i[0]) + graph[block[v]].duration;
 
     int approx_makespan = 0;
     for (int i = 0; i < size; i++) {
         approx_makespan = std::max(approx_makespan, len_to_i[i] + len_from_i[i]);
     }
+    approx_makespan = std::min<int>(approx_makespan, std::numeric_limits<TimeT>::max());
 
     SwapDirection swap_direction = (v - u == 1) ? adjacent : backward;
-    return {sequence, machine, approx_makespan, start_index + u, start_index + v, swap_direction};
+    return {static_cast<TimeT>(approx_makespan), static_cast<IndexT>(machine), static_cast<IndexT>(start_index + u),
+            static_cast<IndexT>(start_index + v), swap_direction};
 }
 
 // the tabu move. sort neighbourhood by approximated makespan, check for aspiration, or take best non tabu solution
@@ -381,175 +563,178 @@ Neighbour TabuSearch::backwardSwap(vector<int> sequence, int const start_index,
 /**
  * select best solution of the neighbourhood as next current solution. exclude tabu solutions if aspiration criterion
  * is not fulfilled
- * @param neighbourhood
  * @return if the new current solution is better than the current one
  */
-bool TabuSearch::tsMove(vector<Neighbour> &neighbourhood) {
+template<typename L, typename Neighbourhood>
+bool TabuSearchEngine<L, Neighbourhood>::tsMove() {
     if (neighbourhood.empty()) {
         return false;
     }
     std::sort(neighbourhood.begin(), neighbourhood.end(), compNeighboursByMakespan);
-    for (auto &neighbour: neighbourhood) {
+    for (auto const &neighbour: neighbourhood) {
+        IndexT const *machine_seq = currentSolution.machine(neighbour.machine);
         if (neighbour.makespan < bestSolution.makespan) {
             // aspiration
-            auto candidate_solution = currentSolution.solution;
-            candidate_solution[neighbour.machine] = neighbour.sequence;
-            int exact_makespan = instance.calcMakespan(candidate_solution);
-            if (exact_makespan >= bestSolution.makespan && tabuList.isTabu(neighbour)) continue;
+            candidateSolution = currentSolution;
+            neighbour.apply(candidateSolution.machine(neighbour.machine));
+            int exact_makespan = calcMakespan(candidateSolution);
+            if (exact_makespan >= bestSolution.makespan && tabuList.isTabu(neighbour, machine_seq)) continue;
 
+            tabuList.updateTabuList(neighbour, machine_seq, bestSolution.makespan);
             updateCurrentSolution(neighbour);
-            tabuList.updateTabuList(neighbour, bestSolution.makespan);
-            currentSolution.solution[neighbour.machine] = neighbour.sequence;
             return true;
-        } else if (!tabuList.isTabu(neighbour)) {
+        } else if (!tabuList.isTabu(neighbour, machine_seq)) {
             // best non tabu
+            tabuList.updateTabuList(neighbour, machine_seq, bestSolution.makespan);
             updateCurrentSolution(neighbour);
-            tabuList.updateTabuList(neighbour, bestSolution.makespan);
-            currentSolution.solution[neighbour.machine] = neighbour.sequence;
             return false;
         }
     }
     // chose random, if all tabu
+    randomMove();
+    return false;
+}
+
+/**
+ * move to a random neighbour, regardless of the tabu list. The neighbourhood must not be empty
+ */
+template<typename L, typename Neighbourhood>
+void TabuSearchEngine<L, Neighbourhood>::randomMove() {
     std::uniform_int_distribution<std::mt19937::result_type> dist(0,neighbourhood.size() - 1);
     auto rand_index = dist(rng);
-    auto &neighbour = neighbourhood[rand_index];
+    auto const &neighbour = neighbourhood[rand_index];
 
+    tabuList.updateTabuList(neighbour, currentSolution.machine(neighbour.machine), bestSolution.makespan);
     updateCurrentSolution(neighbour);
-    tabuList.updateTabuList(neighbour, bestSolution.makespan);
-    currentSolution.solution[neighbour.machine] = neighbour.sequence;
-    return false;
 }
 
 /**
- * changes the disjunctive graph to the new current solution selected by TabuSearch::tsMove
+ * changes the disjunctive graph and the current solution to the neighbour selected by TabuSearchEngine::tsMove
  * @param neighbour
  */
-void TabuSearch::updateCurrentSolution(Neighbour &neighbour) {
-    // find first operation of the machine which is altered
-    std::shared_ptr<Node> node1, node2;
-    int job_node1 = currentSolution.solution[neighbour.machine][neighbour.startIndex];
-    for (auto &node: disjunctiveGraph[job_node1]) {
-        if (node->machine == neighbour.machine) node1 = node;
-    }
-
-    int job_node2 = currentSolution.solution[neighbour.machine][neighbour.endIndex];
-    for (auto &node: disjunctiveGraph[job_node2]) {
-        if (node->machine == neighbour.machine) node2 = node;
-    }
-
-    // execute swap move: rearrange pointers
+template<typename L, typename Neighbourhood>
+void TabuSearchEngine<L, Neighbourhood>::updateCurrentSolution(Neighbour const &neighbour) {
+    auto &graph = disjunctiveGraph;
+    // first and last operation of the machine which are altered
+    IndexT *machine_seq = currentSolution.machine(neighbour.machine);
+    IndexT node1 = operationIds[machine_seq[neighbour.startIndex] * machineCount() + neighbour.machine];
+    IndexT node2 = operationIds[machine_seq[neighbour.endIndex] * machineCount() + neighbour.machine];
+
+    // execute swap move: rearrange links
     if (neighbour.swap == forward) {
-        auto buff_mp = node1->machPredecessor.expired() ? nullptr : node1->machPredecessor.lock();
-        auto buff_ms = node1->machSuccessor;
-        node1->machPredecessor = node2;
-        node1->machSuccessor = node2->machSuccessor;
-        if (node1->machSuccessor) node1->machSuccessor->machPredecessor = node1;
-        node2->machSuccessor = node1;
-
-        if (buff_mp) buff_mp->machSuccessor = buff_ms;
-        if (buff_ms) buff_ms->machPredecessor = buff_mp;
+        IndexT buff_mp = graph[node1].machPredecessor;
+        IndexT buff_ms = graph[node1].machSuccessor;
+        graph[node1].machPredecessor = node2;
+        graph[node1].machSuccessor = graph[node2].machSuccessor;
+        if (graph[node1].machSuccessor != nil) graph[graph[node1].machSuccessor].machPredecessor = node1;
+        graph[node2].machSuccessor = node1;
+
+        if (buff_mp != nil) graph[buff_mp].machSuccessor = buff_ms;
+        if (buff_ms != nil) graph[buff_ms].machPredecessor = buff_mp;
     } else if (neighbour.swap == backward){
-        auto buff_mp = node2->machPredecessor.expired() ? nullptr : node2->machPredecessor.lock();
-        auto buff_ms = node2->machSuccessor;
-        node2->machPredecessor = node1->machPredecessor;
-        node2->machSuccessor = node1;
-        if (!node2->machPredecessor.expired()) node2->machPredecessor.lock()->machSuccessor = node2;
-        node1->machPredecessor = node2;
-
-        if (buff_mp) buff_mp->machSuccessor = buff_ms;
-        if (buff_ms) buff_ms->machPredecessor = buff_mp;
+        IndexT buff_mp = graph[node2].machPredecessor;
+        IndexT buff_ms = graph[node2].machSuccessor;
+        graph[node2].machPredecessor = graph[node1].machPredecessor;
+        graph[node2].machSuccessor = node1;
+        if (graph[node2].machPredecessor != nil) graph[graph[node2].machPredecessor].machSuccessor = node2;
+        graph[node1].machPredecessor = node2;
+
+        if (buff_mp != nil) graph[buff_mp].machSuccessor = buff_ms;
+        if (buff_ms != nil) graph[buff_ms].machPredecessor = buff_mp;
     } else { // neighbour.swap == adjacent
-        auto buff_mp = node1->machPredecessor.expired() ? nullptr : node1->machPredecessor.lock();
-        node1->machSuccessor = node2->machSuccessor;
-        if (node1->machSuccessor) node1->machSuccessor->machPredecessor = node1;
-        node1->machPredecessor = node2;
-
-        node2->machPredecessor = buff_mp;
-        node2->machSuccessor = node1;
-        if (buff_mp) buff_mp->machSuccessor = node2;
-    }
+        IndexT buff_mp = graph[node1].machPredecessor;
+        graph[node1].machSuccessor = graph[node2].machSuccessor;
+        if (graph[node1].machSuccessor != nil) graph[graph[node1].machSuccessor].machPredecessor = node1;
+        graph[node1].machPredecessor = node2;
+
+        graph[node2].machPredecessor = buff_mp;
+        graph[node2].machSuccessor = node1;
+        if (buff_mp != nil) graph[buff_mp].machSuccessor = node2;
+    }
+    // only the positions [startIndex, endIndex] change
+    auto const *keys = zobristKeys.data() + neighbour.machine * jobCount() * jobCount();
+    for (int i = neighbour.startIndex; i <= neighbour.endIndex; i++) currentHash ^= keys[i * jobCount() + machine_seq[i]];
+    neighbour.apply(machine_seq);
+    for (int i = neighbour.startIndex; i <= neighbour.endIndex; i++) currentHash ^= keys[i * jobCount() + machine_seq[i]];
+
+    // leftshift / recalculate starting times and longest paths to the dummy end node
+    calcLongestPaths();
+}
 
-    // leftshift / recalculate starting times
-    // reset all longest paths to dummy end node
-    vector<std::shared_ptr<Node>> start_nodes = vector<std::shared_ptr<Node>>();
-    start_nodes.reserve(2 * instance.machineCount * instance.jobCount);
-    for (auto &job: disjunctiveGraph) {
-        if (job.front()->machPredecessor.expired()) start_nodes.emplace_back(job.front());
-        for (auto &node: job) {
-            node->lenToN = 0;
-            node->start = 0;
+/**
+ * generates the disjunctive graph of the current solution at the start of the optimization
+ */
+template<typename L, typename Neighbourhood>
+void TabuSearchEngine<L, Neighbourhood>::generateDisjunctiveGraph() {
+    int machine_count = machineCount();
+    for (int job = 0; job < jobCount(); job++) {
+        for (int index = 0; index < machine_count; index++) {
+            int op = job * machine_count + index;
+            auto const &operation = instance.instance[job][index];
+            disjunctiveGraph[op] = Node{index > 0 ? static_cast<IndexT>(op - 1) : nil, nil,
+                                        index < machine_count - 1 ? static_cast<IndexT>(op + 1) : nil, nil,
+                                        static_cast<IndexT>(operation.machine), static_cast<IndexT>(job), 0,
+                                        static_cast<TimeT>(operation.duration), 0};
+            operationIds[job * machine_count + operation.machine] = static_cast<IndexT>(op);
         }
     }
-    long long pos = 0;
-    while (pos < start_nodes.size()) {
-        auto &node = start_nodes[pos];
-        auto &ms = node->machSuccessor;
-        auto &js = node->jobSuccessor;
-        auto end = node->start + node->duration;
-        if (ms && ms->start < end) {
-            ms->start = end;
-            start_nodes.emplace_back(ms);
+    for (int machine = 0; machine < machine_count; machine++) {
+        IndexT predecessor = nil;
+        for (int i = 0; i < jobCount(); i++) {
+            IndexT op = operationIds[currentSolution.machine(machine)[i] * machine_count + machine];
+            disjunctiveGraph[op].machPredecessor = predecessor;
+            if (predecessor != nil) disjunctiveGraph[predecessor].machSuccessor = op;
+            predecessor = op;
         }
-        if (js && js->start < end) {
-            js->start = end;
-            start_nodes.emplace_back(js);
-        }
-        ++pos;
-    }
-    auto makespan = 0;
-    for (auto &job: disjunctiveGraph) {
-        makespan = std::max(makespan, job.back()->start + job.back()->duration);
     }
-    currentSolution.makespan = makespan;
+    currentHash = calcHash(currentSolution);
+    calcLongestPaths();
 }
 
 /**
- * generates the disjunctive graph at the start of the optimization
- * @return disjunctive graph
+ * calculate the exact makespan of a solution, durations and machines are taken from the disjunctive graph
+ * @warning: infeasible solutions terminate the program, see JSSPInstance::calcMakespan
+ * @param solution
+ * @return makespan
  */
-vector<vector<std::shared_ptr<Node>>> TabuSearch::generateDisjunctiveGraph() const {
-    auto makespan_machine = vector<int>(instance.machineCount);
-    auto sol_ptr = vector<int>(instance.machineCount);
-    auto makespan_job = vector<int>(instance.jobCount);
-    auto job_ptr = vector<int>(instance.jobCount);
-    auto disjunctive_graph = vector<vector<std::shared_ptr<Node>>>(instance.jobCount);
-    auto disjunctive_arcs = vector<vector<std::shared_ptr<Node>>>(instance.machineCount);
-
-    auto null_node = std::shared_ptr<Node>();
-
-    int op_count = instance.operationCount();
-    while (op_count > 0) {
-        for (int machine = 0; machine < instance.machineCount; machine++) {
-            if (sol_ptr[machine] == static_cast<int>(currentSolution.solution[machine].size())) continue;
-            int job = currentSolution.solution[machine][sol_ptr[machine]];
-            if (instance.instance[job][job_ptr[job]].machine == machine) {
-                int start = std::max(makespan_job[job], makespan_machine[machine]);
-                int duration = instance.instance[job][job_ptr[job]].duration;
-
-                auto job_predecessor = disjunctive_graph[job].empty() ? null_node : disjunctive_graph[job].back();
-                auto machine_predecessor = disjunctive_arcs[machine].empty() ? null_node : disjunctive_arcs[machine].back();
-                auto node = std::make_shared<Node>(Node{job_predecessor, machine_predecessor, nullptr, nullptr, machine, job, start, duration, 0});
-                if (job_predecessor) {
-                    disjunctive_graph[job].back()->jobSuccessor = node;
-                    disjunctive_graph[job].emplace_back(node);
-                } else {
-                    disjunctive_graph[job].emplace_back(node);
-                }
-                if (machine_predecessor) {
-                    disjunctive_arcs[machine].back()->machSuccessor = node;
-                    disjunctive_arcs[machine].back() = node;
-                }else {
-                    disjunctive_arcs[machine].emplace_back(node);
-                    disjunctive_arcs[machine].emplace_back(node);
-                }
-
-                makespan_job[job] = start + duration;
-                makespan_machine[machine] = start + duration;
-                ++sol_ptr[machine];
-                ++job_ptr[job];
-                --op_count;
+template<typename L, typename Neighbourhood>
+int TabuSearchEngine<L, Neighbourhood>::calcMakespan(FlatSolutionT const &solution) {
+    int job_count = jobCount();
+    int machine_count = machineCount();
+    std::fill_n(jobEnd.begin(), job_count, 0);
+    std::fill_n(jobPosition.begin(), job_count, 0);
+    std::fill_n(machineEnd.begin(), machine_count, 0);
+    std::fill_n(machinePosition.begin(), machine_count, 0);
+
+    int ops_left = job_count * machine_count;
+    long error_detection = 0;
+    while (ops_left > 0) {
+        error_detection += 1;
+        for (int machine = 0; machine < machine_count; machine++) {
+            if (machinePosition[machine] == job_count) continue;
+            int job = solution.machine(machine)[machinePosition[machine]];
+            auto const &node = disjunctiveGraph[job * machine_count + jobPosition[job]];
+            if (node.machine == machine) {
+                int start = std::max(jobEnd[job], machineEnd[machine]);
+                if (!releaseTimes.empty()) start = std::max<int>(start, releaseTimes[job * machine_count + jobPosition[job]]);
+                int end = start + node.duration;
+                jobEnd[job] = end;
+                machineEnd[machine] = end;
+                ++machinePosition[machine];
+                ++jobPosition[job];
+                --ops_left;
+                error_detection = 0;
             }
         }
+        if (error_detection > ops_left) {
+            std::cout << "Error in solution detected. Terminating..." << std::endl;
+            exit(1);
+        }
     }
-    return disjunctive_graph;
-}
\ No newline at end of file
+    return *std::max_element(machineEnd.begin(), machineEnd.begin() + machine_count);
+}
+
+#define INSTANTIATE_TABU_SEARCH(IndexT, TimeT) \
+    template std::unique_ptr<TabuSearchCore<IndexT, TimeT>> makeTabuSearch<Layout<IndexT, TimeT>>(JSSPInstance &instance, \
+                                                                                                  NeighbourhoodStructure neighbourhood);
+JSSP_LAYOUTS(INSTANTIATE_TABU_SEARCH)
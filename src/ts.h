@@ -4,118 +4,467 @@
 #include <memory>
 #include <chrono>
 #include <iostream>
+#include <algorithm>
+#include <functional>
 #include "jssp.h"
+#include "layout.h"
+#include "neighbourhood.h"
+#include "elite_archive.h"
+#include "disjunctive_graph.h"
 
-enum SwapDirection {forward, backward, adjacent};
+enum SwapDirection : uint8_t {forward, backward, adjacent};
 /**
- * internal struct for managing the neighbouring solutions
+ * internal struct for managing the neighbouring solutions.
+ * only the move is stored: the operation at startIndex moves behind endIndex (forward) or the operation at endIndex
+ * moves before startIndex (backward), adjacent swaps both. The machine sequence is derived from the current solution
  */
-struct Neighbour {
-    vector<int> sequence;
-    int machine;
-    int makespan;
-    int startIndex;
-    int endIndex;
+template<typename IndexT, typename TimeT>
+struct BasicNeighbour {
+    TimeT makespan;
+    IndexT machine;
+    IndexT startIndex;
+    IndexT endIndex;
     SwapDirection swap;
+
+    // job at position i of the machine sequence after the move, machine_seq is the sequence before the move
+    [[nodiscard]] inline IndexT jobAt(IndexT const *machine_seq, int i) const {
+        if (i < startIndex || i > endIndex) return machine_seq[i];
+        if (swap == backward) return i == startIndex ? machine_seq[endIndex] : machine_seq[i - 1];
+        return i == endIndex ? machine_seq[startIndex] : machine_seq[i + 1];
+    }
+
+    // execute the move on the machine sequence
+    inline void apply(IndexT *machine_seq) const {
+        if (swap == backward) {
+            std::rotate(machine_seq + startIndex, machine_seq + endIndex, machine_seq + endIndex + 1);
+        } else {
+            std::rotate(machine_seq + startIndex, machine_seq + startIndex + 1, machine_seq + endIndex + 1);
+        }
+    }
 };
+#include "tabu_list.h"
+
 /**
- * internal struct for managing the operations in the disjunctive graph
+ * counters of the tabu search since construction or the last resetStatistics()
+ * revisits: iterations which returned to a solution of the cycle detection window
+ * escapes: number of escapes started because of a revisit, see TabuSearch::setCycleDetection
+ * perturbations / restarts: diversifications of optimize after stagnation, see TabuSearch::setDiversification
  */
-struct Node {
-    std::weak_ptr<Node> jobPredecessor;
-    std::weak_ptr<Node> machPredecessor;
-    std::shared_ptr<Node> jobSuccessor;
-    std::shared_ptr<Node> machSuccessor;
-    int machine;
-    int job;
-    int start;
-    int duration;
-    int lenToN;
+struct TabuSearchStatistics {
+    long iterations = 0;
+    long revisits = 0;
+    long escapes = 0;
+    long perturbations = 0;
+    long restarts = 0;
 };
 
-#include "tabu_list.h"
+// called by optimize with each new best solution and the seconds since the start of the run, see setImprovementCallback
+using ImprovementCallback = std::function<void(Solution const &solution, double seconds)>;
 
-class TabuSearch {
+/**
+ * interface of the tabu search, independent of the layout. See TabuSearch
+ */
+class TabuSearchBase {
 public:
-    explicit TabuSearch (JSSPInstance &instance):
-    instance(instance), rng(instance.getSeed()), tabuList(instance) { };
+    virtual ~TabuSearchBase() = default;
 
-    // optimize a given solution for maxIteration iterations. mainly for memetic algorithm.
-    Solution optimize_it(Solution &solution, long max_iterations);
+    virtual Solution optimize_it(Solution const &solution, long max_iterations, long max_stagnation) = 0;
+    virtual BMResult optimize(Solution const &solution, int seconds, int lower_bound) = 0;
+    virtual void start(Solution const &solution, int lower_bound) = 0;
+    virtual bool step(long max_iterations, double seconds) = 0;
+    [[nodiscard]] virtual Solution best() const = 0;
+    virtual BMResult finish() = 0;
+    virtual void setTabuListParams(int _tt, int _d1, int _d2, unsigned int _tabuListSize) = 0;
+    virtual void setCycleDetection(int window, int escape_moves) = 0;
+    virtual void setDiversification(long stagnation_iterations, int perturbation_moves, int restart_interval) = 0;
+    virtual void setTargetGap(double gap) = 0;
+    virtual void setReleaseTimes(vector<int> const &release) = 0;
+    virtual void setFixedPrefix(vector<int> const &lengths) = 0;
+    virtual void setKeepTabuList(bool keep) = 0;
+    virtual void setImprovementCallback(ImprovementCallback callback) = 0;
+    [[nodiscard]] virtual TabuSearchStatistics const &statistics() const = 0;
+    virtual void resetStatistics() = 0;
+    virtual Solution relink(Solution const &initiating, Solution const &guiding) = 0;
+    virtual void setEliteArchive(int capacity, int min_distance) = 0;
+    [[nodiscard]] virtual vector<Solution> elites() const = 0;
+};
 
-    // standalone mode / logging on. optimize a solution for a maximum amount of seconds, regardless the time constraint
-    BMResult optimize(Solution &solution, int seconds, int lower_bound=0);
+/**
+ * tabu search on the flat solutions of one layout, used by the algorithms built on the tabu search (memetic algorithm),
+ * which run on the same layout. Create with makeTabuSearch
+ */
+template<typename IndexT, typename TimeT>
+class TabuSearchCore : public TabuSearchBase {
+public:
+    using FlatSolutionT = BasicFlatSolution<IndexT, TimeT>;
 
-    // OPTIONAL: set tabu list parameters -> influence how long items are forbidden. See tabuList for details.
-    void setTabuListParams(int _tt=2, int _d1=5, int _d2=12, unsigned int _tabuListSize= 0) {
+    // optimize a given solution for maxIteration iterations, or until max_stagnation iterations without improvement
+    // (0: no limit). The result stays valid until the next call
+    virtual FlatSolutionT const &optimize_it(FlatSolutionT const &solution, long max_iterations, long max_stagnation) = 0;
+    // iteration of the last improvement of the best solution in the last optimize_it call
+    [[nodiscard]] virtual long lastImprovement() const = 0;
+    virtual BMResult optimize(FlatSolutionT const &solution, int seconds, int lower_bound) = 0;
+    virtual void start(FlatSolutionT const &solution, int lower_bound) = 0;
+    // path relinking from initiating towards guiding, the selected solution of the path is written to result
+    virtual void relink(FlatSolutionT const &initiating, FlatSolutionT const &guiding, FlatSolutionT &result) = 0;
+    // elite solutions of the last optimize run
+    [[nodiscard]] virtual BasicEliteArchive<IndexT, TimeT> const &eliteArchive() const = 0;
+
+    Solution optimize_it(Solution const &solution, long max_iterations, long max_stagnation) override {
+        return optimize_it(FlatSolutionT(solution), max_iterations, max_stagnation).toSolution();
+    };
+    BMResult optimize(Solution const &solution, int seconds, int lower_bound) override {
+        return optimize(FlatSolutionT(solution), seconds, lower_bound);
+    };
+    void start(Solution const &solution, int lower_bound) override { start(FlatSolutionT(solution), lower_bound); };
+    Solution relink(Solution const &initiating, Solution const &guiding) override {
+        FlatSolutionT result;
+        relink(FlatSolutionT(initiating), FlatSolutionT(guiding), result);
+        return result.toSolution();
+    };
+    [[nodiscard]] vector<Solution> elites() const override { return eliteArchive().toSolutions(); };
+};
+
+// tabu search for the layout L, see layout.h, with the given neighbourhood structure
+template<typename L>
+std::unique_ptr<TabuSearchCore<typename L::Index, typename L::Time>> makeTabuSearch(JSSPInstance &instance,
+                                                                                    NeighbourhoodStructure neighbourhood = n7);
+
+/**
+ * the tabu search implementation. The disjunctive graph is a flat array of nodes, operation id = job * #machines +
+ * index of the operation in the job, linked by ids of type L::Index.
+ * for layouts with compile time dimensions all buffers are std::arrays inside the object and the loops over jobs,
+ * machines and operations have constant trip counts.
+ * Neighbourhood is the neighbourhood policy, see neighbourhood.h
+ */
+template<typename L, typename Neighbourhood = N7Neighbourhood>
+class TabuSearchEngine : public TabuSearchCore<typename L::Index, typename L::Time> {
+public:
+    using IndexT = typename L::Index;
+    using TimeT = typename L::Time;
+    using FlatSolutionT = BasicFlatSolution<IndexT, TimeT>;
+    using Neighbour = BasicNeighbour<IndexT, TimeT>;
+    using Node = BasicNode<IndexT, TimeT>;
+    using TabuSearchCore<IndexT, TimeT>::optimize_it;
+    using TabuSearchCore<IndexT, TimeT>::optimize;
+    using TabuSearchCore<IndexT, TimeT>::relink;
+    using TabuSearchCore<IndexT, TimeT>::start;
+
+    explicit TabuSearchEngine(JSSPInstance &instance);
+
+    FlatSolutionT const &optimize_it(FlatSolutionT const &solution, long max_iterations, long max_stagnation) override;
+
+    [[nodiscard]] long lastImprovement() const override { return lastImprovementIteration; };
+
+    BMResult optimize(FlatSolutionT const &solution, int seconds, int lower_bound) override;
+
+    void start(FlatSolutionT const &solution, int lower_bound) override;
+
+    bool step(long max_iterations, double seconds) override;
+
+    [[nodiscard]] Solution best() const override { return bestSolution.toSolution(); };
+
+    BMResult finish() override;
+
+    void setTabuListParams(int _tt, int _d1, int _d2, unsigned int _tabuListSize) override {
         tabuList.setTabuParams(_tt, _d1, _d2, _tabuListSize);};
 
+    void setCycleDetection(int window, int escape_moves) override { cycleWindow = window; escapeMoves = escape_moves; };
+
+    void setDiversification(long stagnation_iterations, int perturbation_moves, int restart_interval) override {
+        stagnationIterations = stagnation_iterations; perturbationMoves = perturbation_moves; restartInterval = restart_interval;};
+
+    void setTargetGap(double gap) override { targetGap = gap; };
+
+    void setReleaseTimes(vector<int> const &release) override { releaseTimes.assign(release.begin(), release.end()); };
+
+    void setFixedPrefix(vector<int> const &lengths) override { fixedPrefix = lengths; };
+
+    void setKeepTabuList(bool keep) override { keepTabuList = keep; };
+
+    void setImprovementCallback(ImprovementCallback callback) override { improvementCallback = std::move(callback); };
+
+    [[nodiscard]] TabuSearchStatistics const &statistics() const override { return searchStatistics; };
+
+    void resetStatistics() override { searchStatistics = TabuSearchStatistics(); };
+
+    void relink(FlatSolutionT const &initiating, FlatSolutionT const &guiding, FlatSolutionT &result) override;
+
+    void setEliteArchive(int capacity, int min_distance) override { archive.setParams(capacity, min_distance); };
+
+    [[nodiscard]] BasicEliteArchive<IndexT, TimeT> const &eliteArchive() const override { return archive; };
+
 private:
+    // the checks in tests/ compare the internals with reference implementations
+    friend struct TabuSearchCheck;
+
+    static constexpr IndexT nil = L::nil;
+    // number of operations, 0 if the dimensions are not known at compile time
+    static constexpr int fixedOperations = L::jobs * L::machines;
+
     // constructor fields
     JSSPInstance &instance;
-    TabuList tabuList;
+    BasicTabuList<IndexT, TimeT> tabuList;
 
     // logging intermediate makespans while running in standalone mode
     vector<std::tuple<double, int>> makespanHistory;
+    // streaming of the new best solutions of optimize, see setImprovementCallback
+    ImprovementCallback improvementCallback;
 
     // initialized on starting search
-    Solution currentSolution;
-    Solution bestSolution;
-    vector<vector<std::shared_ptr<Node>>> disjunctiveGraph;
+    FlatSolutionT currentSolution;
+    FlatSolutionT bestSolution;
+    // buffer for the exact makespan calculation of a neighbour
+    FlatSolutionT candidateSolution;
+    // operations of the current solution, see class description
+    Buffer<Node, fixedOperations> disjunctiveGraph;
+    // operation id of job j on machine m: operationIds[j * #machines + m]
+    Buffer<IndexT, fixedOperations> operationIds;
     std::mt19937 rng;
 
+    // buffers of one iteration, allocated once
+    Buffer<IndexT, fixedOperations> topologicalOrder;
+    Buffer<uint8_t, fixedOperations> predecessorCount;
+    Buffer<IndexT, fixedOperations> longestPath;
+    int longestPathLength = 0;
+    // blocks as [begin, end) ranges of longestPath
+    vector<std::pair<int, int>> blockList;
+    vector<Neighbour> neighbourhood;
+    Buffer<int, L::jobs> lenToI;
+    Buffer<int, L::jobs> lenFromI;
+    // buffers of calcMakespan
+    Buffer<int, L::jobs> jobEnd;
+    Buffer<int, L::jobs> jobPosition;
+    Buffer<int, L::machines> machineEnd;
+    Buffer<int, L::machines> machinePosition;
+
+    // cycle detection, see recordVisit
+    // zobrist key of job j at position p of machine m: zobristKeys[(m * #jobs + p) * #jobs + j]
+    vector<uint64_t> zobristKeys;
+    // zobrist hash of currentSolution, updated with each move
+    uint64_t currentHash = 0;
+    // hashes of the last visitCount (<= cycleWindow) solutions, ring buffer
+    vector<uint64_t> visitWindow;
+    int visitCount = 0;
+    int visitPosition = 0;
+    // number of hashes in visitWindow per bucket (low hash bits), visitWindow is only searched for a non-empty bucket
+    vector<uint16_t> visitBuckets;
+    // 0: disabled, see setCycleDetection
+    int cycleWindow = 0;
+    int escapeMoves = 2;
+    // remaining random moves of the current escape
+    int pendingEscapeMoves = 0;
+    TabuSearchStatistics searchStatistics;
+    // see lastImprovement
+    long lastImprovementIteration = 0;
+
+    // diversification of optimize: after stagnationIterations iterations without a new best solution do
+    // perturbationMoves random moves, each restartInterval-th time in a row start them from an elite. 0: disabled, see
+    // setDiversification
+    long stagnationIterations = 0;
+    int perturbationMoves = 20;
+    int restartInterval = 3;
+    // optimize stops when the relative gap to the lower bound of the instance is reached, see JSSPInstance::stopMakespan
+    double targetGap = 0;
+    // state of the run of start and step: iterations since the last new best solution, diversifications since then and
+    // the makespan at which the run stops
+    long runStagnation = 0;
+    int runDiversifications = 0;
+    int runStopMakespan = 0;
+
+    // rescheduling, see TabuSearch::setReleaseTimes and setFixedPrefix. Empty: no release times / all positions movable
+    vector<TimeT> releaseTimes;
+    vector<int> fixedPrefix;
+    // optimize and optimize_it continue with the tabu list of the last run
+    bool keepTabuList = false;
+
+    // best mutually distant solutions of the last optimize run
+    BasicEliteArchive<IndexT, TimeT> archive;
+    // operation ids of the machine sequence segment of a path relinking move
+    Buffer<IndexT, L::jobs> relinkSegment;
+    // range of differing positions of each machine during path relinking, see relink
+    Buffer<int, L::machines> relinkLow, relinkHigh;
+
     // counter
     std::chrono::time_point<std::chrono::system_clock> startTime;
 
+    // one iteration: tabu move or escape move, followed by the cycle detection
+    void iterate();
+
     // tabu move methods
-    bool tsMove(vector<Neighbour> &neighbourhood);
+    bool tsMove();
+    void randomMove();
+
+    // zobrist hash of a solution
+    [[nodiscard]] uint64_t calcHash(FlatSolutionT const &solution) const;
 
-    // generate N7 like neighbourhood to a solution
-    vector<Neighbour> generateNeighbourhood();
+    // clear the cycle detection window at the start of a search
+    void resetVisits();
+
+    // add the current solution to the window, start an escape if it was visited before
+    void recordVisit();
+
+    // perturbation of the current solution, optionally restarting from an elite solution, see optimize
+    void diversify(bool restart);
+
+    // N7 move of the segment [start_index, end_index] of a machine for path relinking, false if it is infeasible
+    bool relinkMove(int machine, int start_index, int end_index, SwapDirection direction, Neighbour &move);
+
+    // generate the neighbourhood of the current solution
+    void generateNeighbourhood();
 
     // log new best makespan and time while running
     void logMakespan(int makespan);
 
     // generate the initial disjunctive graph
-    [[nodiscard]] vector<vector<std::shared_ptr<Node>>> generateDisjunctiveGraph() const;
+    void generateDisjunctiveGraph();
 
-    // update the disjunctive graph to the neighbouring solution
-    void updateCurrentSolution(Neighbour &neighbour);
+    // exact makespan of a solution, same as JSSPInstance::calcMakespan without allocations
+    int calcMakespan(FlatSolutionT const &solution);
 
-    // find the longest path in the graph, values are precalculated in calcLongestPaths
-    [[nodiscard]] vector<std::shared_ptr<Node>> findLongestPath(const vector<vector<std::shared_ptr<Node>>>& disjunctive_graph) const;
+    // update the disjunctive graph to the neighbouring solution
+    void updateCurrentSolution(Neighbour const &neighbour);
 
-    // calc the len to n for each operation, so the longest path to the finishing operation
-    void calcLongestPaths(vector<vector<std::shared_ptr<Node>>> &disjunctive_graph) const;
+    // calc start and len to n of each operation and the makespan of the current solution
+    void calcLongestPaths();
 
-    // recursive DSF for calcLongestPaths
-    void recursiveLongestPathCalculation(const std::shared_ptr<Node>& node) const;
+    // find the longest path in the graph, values are precalculated in calcLongestPaths
+    void findLongestPath();
 
     // preprocess the longest path to identify the blocks for a swap move, to generate neighbouring solutions
-    [[nodiscard]] static vector<vector<std::shared_ptr<Node>>> generateBlockList(const vector<std::shared_ptr<Node>> &longest_path) ;
+    void generateBlockList();
 
     // use a block of the longest path to generate neighbouring solutions
-    [[nodiscard]] vector<Neighbour> generateNeighboursFromBlock(const vector<std::shared_ptr<Node>> &block) const;
+    void generateNeighboursFromBlock(IndexT const *block, int block_size, bool path_start, bool path_end);
+
+    // moves inside one block of the longest path, handed to the neighbourhood policy
+    struct BlockMoves {
+        TabuSearchEngine &engine;
+        IndexT const *block;
+        int startIndex;
+        int machine;
+
+        inline bool canMoveForward(int u, int v) const { return engine.checkForwardSwap(block[u], block[v]); }
+        inline bool canMoveBackward(int u, int v) const { return engine.checkBackwardSwap(block[u], block[v]); }
+        inline void forward(int u, int v) {
+            if (engine.isMovable(machine, startIndex + u)) engine.neighbourhood.emplace_back(engine.forwardSwap(startIndex, u, v, machine, block)); }
+        inline void backward(int u, int v) {
+            if (engine.isMovable(machine, startIndex + u)) engine.neighbourhood.emplace_back(engine.backwardSwap(startIndex, u, v, machine, block)); }
+    };
 
     // swap an operation forward in its block and estimate the makespan, to create a new neighbouring solution
-    Neighbour static forwardSwap(vector<int> sequence, int start_index, int u, int v, int machine, vector<std::shared_ptr<Node>> const &block);
+    Neighbour forwardSwap(int start_index, int u, int v, int machine, IndexT const *block);
     // swap an operation backward in its block and estimate the makespan, to create a new neighbouring solution
-    Neighbour static backwardSwap(vector<int> sequence, int start_index, int u, int v, int machine, vector<std::shared_ptr<Node>> const &block);
+    Neighbour backwardSwap(int start_index, int u, int v, int machine, IndexT const *block);
 
+    // dimensions of the instance, compile time constants if known
+    [[nodiscard]] inline int jobCount() const {
+        if constexpr (L::jobs != 0) return L::jobs; else return instance.jobCount;
+    }
+    [[nodiscard]] inline int machineCount() const {
+        if constexpr (L::machines != 0) return L::machines; else return instance.machineCount;
+    }
+    // moves which change a position in front of it are allowed, see setFixedPrefix
+    [[nodiscard]] inline bool isMovable(int machine, int position) const {
+        return fixedPrefix.empty() || position >= fixedPrefix[machine];
+    }
+    // end of an operation, 0 for nil
+    [[nodiscard]] inline int endTime(IndexT op) const {
+        return op == nil ? 0 : disjunctiveGraph[op].start + disjunctiveGraph[op].duration;
+    }
+    // length of the longest path from the start of an operation to the end, 0 for nil
+    [[nodiscard]] inline int tailLength(IndexT op) const {
+        return op == nil ? 0 : disjunctiveGraph[op].lenToN + disjunctiveGraph[op].duration;
+    }
     // check if two operations in a block can be swapped, used in generateNeighboursFromBlock
-    inline static bool checkForwardSwap(std::shared_ptr<Node> const &u, std::shared_ptr<Node> const &v) {
-        return !u->jobSuccessor || v->lenToN + v->duration >= u->jobSuccessor->lenToN + u->jobSuccessor->duration;
+    [[nodiscard]] inline bool checkForwardSwap(IndexT u, IndexT v) const {
+        return disjunctiveGraph[u].jobSuccessor == nil || tailLength(v) >= tailLength(disjunctiveGraph[u].jobSuccessor);
     }
     // check if two operations in a block can be swapped, used in generateNeighboursFromBlock
-    inline static bool checkBackwardSwap(std::shared_ptr<Node> const &u, std::shared_ptr<Node> const &v) {
-        return v->jobPredecessor.expired() || u->start + u->duration >= v->jobPredecessor.lock()->start + v->jobPredecessor.lock()->duration;
+    [[nodiscard]] inline bool checkBackwardSwap(IndexT u, IndexT v) const {
+        return disjunctiveGraph[v].jobPredecessor == nil || endTime(u) >= endTime(disjunctiveGraph[v].jobPredecessor);
     }
     inline static bool compNeighboursByMakespan(Neighbour const &n1, Neighbour const &n2) {
         return n1.makespan < n2.makespan;
     }
-    inline static bool compNodesByEndTime(std::shared_ptr<Node> const &rhs, std::shared_ptr<Node> const &lhs) {
-        return rhs->start + rhs->duration > lhs->start + lhs->duration;
-    }
+};
+
+/**
+ * tabu search for the job shop scheduling problem. Runs on the narrowest layout which fits the instance, see layout.h.
+ * the neighbourhood structure is fixed on construction, see neighbourhood.h
+ */
+class TabuSearch {
+public:
+    // time_horizon: latest release time, see setReleaseTimes
+    explicit TabuSearch (JSSPInstance &instance, NeighbourhoodStructure neighbourhood = n7, int time_horizon = 0);
+
+    // optimize a given solution for maxIteration iterations, stop early after max_stagnation iterations without
+    // improvement (0: never). mainly for memetic algorithm.
+    Solution optimize_it(Solution &solution, long max_iterations, long max_stagnation=0) {
+        return engine->optimize_it(solution, max_iterations, max_stagnation); };
+
+    // standalone mode / logging on. optimize a solution for a maximum amount of seconds, regardless the time constraint
+    BMResult optimize(Solution &solution, int seconds, int lower_bound=0) { return engine->optimize(solution, seconds, lower_bound); };
+
+    // resumable run, the same search as optimize in slices, so one thread can interleave many searches: start a run on a
+    // solution, continue it with step for max_iterations iterations and / or seconds (0: no limit, set at least one),
+    // best solution so far with best, result with finish. The run is kept between the calls, step returns false when
+    // the lower bound is reached. optimize, optimize_it and relink in between end the run
+    void start(Solution const &solution, int lower_bound=0) { engine->start(solution, lower_bound); };
+    bool step(long max_iterations, double seconds=0) { return engine->step(max_iterations, seconds); };
+    [[nodiscard]] Solution best() const { return engine->best(); };
+    BMResult finish() { return engine->finish(); };
+
+    // OPTIONAL: set tabu list parameters -> influence how long items are forbidden. See tabuList for details.
+    void setTabuListParams(int _tt=2, int _d1=5, int _d2=12, unsigned int _tabuListSize= 0) {
+        engine->setTabuListParams(_tt, _d1, _d2, _tabuListSize);};
+
+    // OPTIONAL: if the search returns to one of the last window solutions, do escape_moves random moves. Off by default,
+    // window 0 disables it
+    void setCycleDetection(int window=200, int escape_moves=2) { engine->setCycleDetection(window, escape_moves); };
+
+    // OPTIONAL: optimize perturbs the current solution with perturbation_moves random moves after stagnation_iterations
+    // iterations without improvement, each restart_interval-th time in a row it restarts from an elite solution
+    // instead. Off by default, stagnation_iterations 0 disables it
+    void setDiversification(long stagnation_iterations=20000, int perturbation_moves=20, int restart_interval=3) {
+        engine->setDiversification(stagnation_iterations, perturbation_moves, restart_interval);};
+
+    // OPTIONAL: optimize stops, when the makespan is within the relative gap of the instance lower bound
+    // (JSSPInstance::lowerBound). 0: stop only at a proven optimum
+    void setTargetGap(double gap=0) { engine->setTargetGap(gap); };
+
+    // OPTIONAL: earliest start of each operation (id job * #machines + index in the job), e.g. the current time of a
+    // running shop. Empty: all operations start at 0. The latest release time has to be passed to the constructor as
+    // time_horizon. The makespan approximation of the moves ignores them, the exact makespan does not
+    void setReleaseTimes(vector<int> const &release={}) { engine->setReleaseTimes(release); };
+
+    // OPTIONAL: the first lengths[m] jobs of machine m keep their positions, e.g. operations which already started.
+    // Empty: all positions are movable
+    void setFixedPrefix(vector<int> const &lengths={}) { engine->setFixedPrefix(lengths); };
+
+    // OPTIONAL: optimize and optimize_it continue with the tabu list of the previous run instead of an empty one, for
+    // a search which is resumed on a slightly changed instance
+    void setKeepTabuList(bool keep=false) { engine->setKeepTabuList(keep); };
+
+    // OPTIONAL: optimize calls callback with each new best solution (and the start solution), e.g. to stream them to a
+    // client while the search runs. Empty: no calls
+    void setImprovementCallback(ImprovementCallback callback={}) { engine->setImprovementCallback(std::move(callback)); };
+
+    // revisit and diversification statistics, see TabuSearchStatistics
+    [[nodiscard]] TabuSearchStatistics const &statistics() const { return engine->statistics(); };
+    void resetStatistics() { engine->resetStatistics(); };
+
+    // path relinking: a solution between initiating and guiding, which combines features of both. See TabuSearchEngine::relink
+    Solution relink(Solution const &initiating, Solution const &guiding) { return engine->relink(initiating, guiding); };
+
+    // best mutually distant solutions found by the last optimize run, best first
+    [[nodiscard]] vector<Solution> elites() const { return engine->elites(); };
+
+    // OPTIONAL: size of the elite archive and minimum sequence distance of two elites, see BasicEliteArchive
+    void setEliteArchive(int capacity=10, int min_distance=3) { engine->setEliteArchive(capacity, min_distance); };
+
+private:
+    std::unique_ptr<TabuSearchBase> engine;
 };
 
 
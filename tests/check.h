@@ -0,0 +1,97 @@
+#ifndef HYBRID_EVO_ALGORITHM_CHECK_H
+#define HYBRID_EVO_ALGORITHM_CHECK_H
+
+#include <iostream>
+#include <string>
+#include <algorithm>
+#include "jssp.h"
+
+/**
+ * minimal checks for the test executables: CHECK reports a failed condition and continues, main returns
+ * checkResult(), which is non-zero if any check failed. INSTANCE_DIR is set by tests/CMakeLists.txt
+ */
+inline int checkFailures = 0;
+
+#define CHECK(condition) do { if (!(condition)) { \
+    std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl; ++checkFailures; } } while (0)
+
+inline int checkResult() {
+    if (checkFailures > 0) std::cerr << checkFailures << " checks failed" << std::endl;
+    return checkFailures > 0 ? 1 : 0;
+}
+
+// path of an instance file, e.g. instancePath("ft", "ft06")
+inline std::string instancePath(std::string const &set, std::string const &name) {
+    return std::string(INSTANCE_DIR) + set + "_instances/" + name + ".txt";
+}
+
+/**
+ * semi-active schedule of the machine sequences, computed independently of the algorithms: each operation starts when
+ * its job predecessor and its machine predecessor are finished
+ * @return start time of each operation of each job, empty if the solution is not a feasible set of permutations
+ */
+inline vector<vector<long long>> scheduleStarts(JSSPInstance const &instance, vector<vector<int>> const &solution) {
+    int job_count = instance.jobCount, machine_count = instance.machineCount;
+    if (static_cast<int>(solution.size()) != machine_count) return {};
+    auto starts = vector<vector<long long>>(job_count, vector<long long>(machine_count, -1));
+    auto next_operation = vector<int>(job_count), next_position = vector<int>(machine_count);
+    auto job_end = vector<long long>(job_count), machine_end = vector<long long>(machine_count);
+    for (int scheduled = 0; scheduled < job_count * machine_count;) {
+        bool progress = false;
+        for (int machine = 0; machine < machine_count; machine++) {
+            if (static_cast<int>(solution[machine].size()) != job_count) return {};
+            if (next_position[machine] == job_count) continue;
+            int job = solution[machine][next_position[machine]];
+            if (job < 0 || job >= job_count || next_operation[job] == machine_count) return {};
+            auto const &operation = instance.instance[job][next_operation[job]];
+            if (operation.machine != machine) continue;
+            long long start = std::max(job_end[job], machine_end[machine]);
+            starts[job][next_operation[job]++] = start;
+            job_end[job] = machine_end[machine] = start + operation.duration;
+            ++next_position[machine];
+            ++scheduled;
+            progress = true;
+        }
+        // a cycle or a job twice on a machine
+        if (!progress) return {};
+    }
+    return starts;
+}
+
+// makespan of a schedule of scheduleStarts
+inline long long scheduleMakespan(JSSPInstance const &instance, vector<vector<long long>> const &starts) {
+    long long makespan = 0;
+    for (int job = 0; job < instance.jobCount; job++) {
+        for (int i = 0; i < instance.machineCount; i++) makespan = std::max(makespan, starts[job][i] + instance.instance[job][i].duration);
+    }
+    return makespan;
+}
+
+/**
+ * whether the semi-active schedule of the machine sequences is active: no operation fits into an idle gap of its
+ * machine before its start, after its job predecessor
+ */
+inline bool isActive(JSSPInstance const &instance, vector<vector<int>> const &solution, vector<vector<long long>> const &starts) {
+    auto operation_index = vector<vector<int>>(instance.jobCount, vector<int>(instance.machineCount));
+    for (int job = 0; job < instance.jobCount; job++) {
+        for (int i = 0; i < instance.machineCount; i++) operation_index[job][instance.instance[job][i].machine] = i;
+    }
+    for (int machine = 0; machine < instance.machineCount; machine++) {
+        for (size_t k = 0; k < solution[machine].size(); k++) {
+            int job = solution[machine][k];
+            int index = operation_index[job][machine];
+            long long ready = index == 0 ? 0 : starts[job][index - 1] + instance.instance[job][index - 1].duration;
+            long long gap_start = 0;
+            for (size_t g = 0; g < k; g++) {
+                int other = solution[machine][g];
+                int other_index = operation_index[other][machine];
+                long long gap_end = starts[other][other_index];
+                if (std::max(gap_start, ready) + instance.instance[job][index].duration <= gap_end) return false;
+                gap_start = gap_end + instance.instance[other][other_index].duration;
+            }
+        }
+    }
+    return true;
+}
+
+#endif //HYBRID_EVO_ALGORITHM_CHECK_H
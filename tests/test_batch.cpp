@@ -0,0 +1,48 @@
+#include <set>
+#include <chrono>
+#include "check.h"
+#include "batch.h"
+
+// every task is reported once with a consistent solution, tasks at their lower bound stop before their budget
+void checkBatch() {
+    string ft06_path = instancePath("ft", "ft06"), la24_path = instancePath("la", "la24");
+    JSSPInstance ft06(ft06_path, 1), la24(la24_path, 1);
+    BatchSolver solver(2, 0.02);
+    auto instances = vector<JSSPInstance const *>();
+    for (int i = 0; i < 6; i++) {
+        CHECK(solver.add(ft06, 5, i % 3, i % 2 == 0 ? batch_tabu_search : batch_memetic, 55) == instances.size());
+        instances.push_back(&ft06);
+    }
+    for (int i = 0; i < 2; i++) {
+        CHECK(solver.add(la24, 0.3, 0, i == 0 ? batch_tabu_search : batch_memetic) == instances.size());
+        instances.push_back(&la24);
+    }
+
+    auto reported = std::multiset<size_t>();
+    auto reported_makespans = vector<int>(instances.size());
+    auto begin = std::chrono::steady_clock::now();
+    auto results = solver.solve([&](size_t task, BMResult const &result) {
+        reported.insert(task);
+        if (task < reported_makespans.size()) reported_makespans[task] = result.makespan;
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    CHECK(results.size() == instances.size());
+    if (results.size() != instances.size()) return;
+    for (size_t task = 0; task < instances.size(); task++) {
+        CHECK(reported.count(task) == 1);
+        auto const &result = results[task];
+        CHECK(reported_makespans[task] == result.makespan);
+        auto starts = scheduleStarts(*instances[task], result.solution);
+        CHECK(!starts.empty() && scheduleMakespan(*instances[task], starts) == result.makespan);
+        if (instances[task] == &ft06) CHECK(result.makespan == 55);
+    }
+    // the ft06 budgets (30 s) are not used up
+    CHECK(seconds < 10);
+    CHECK(solver.statistics().slices > 0);
+}
+
+int main() {
+    checkBatch();
+    return checkResult();
+}
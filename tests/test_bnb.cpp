@@ -0,0 +1,98 @@
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include "check.h"
+#include "bnb.h"
+#include "heuristics.h"
+
+// optimum of a full instance: proven, with a feasible solution of this makespan, also from a start solution
+void checkOptimum(string const &set, string const &name, int optimum) {
+    string path = instancePath(set, name);
+    JSSPInstance instance(path, 1);
+    auto result = BranchAndBound(instance).solve();
+    CHECK(result.optimal && result.solution.makespan == optimum && result.lowerBound == optimum);
+    auto starts = scheduleStarts(instance, result.solution.solution);
+    CHECK(!starts.empty() && scheduleMakespan(instance, starts) == optimum);
+
+    auto started = BranchAndBound(instance).solve(Heuristics::shiftingBottleneck(instance));
+    CHECK(started.optimal && started.solution.makespan == optimum);
+}
+
+/**
+ * max(C + delivery) of machine sequences with release and delivery times, computed independently of the branch and
+ * bound: semi-active schedule, operations start after their release time
+ * @return objective, max of int if the sequences contain a cycle
+ */
+int problemObjective(BranchAndBoundProblem const &problem, vector<vector<int>> const &sequences) {
+    int job_count = static_cast<int>(problem.jobs.size());
+    auto next_operation = vector<int>(job_count), next_position = vector<int>(problem.machineCount);
+    auto job_end = vector<int>(job_count), machine_end = vector<int>(problem.machineCount);
+    int objective = 0, scheduled = 0, total = job_count * problem.machineCount;
+    while (scheduled < total) {
+        bool progress = false;
+        for (int machine = 0; machine < problem.machineCount; machine++) {
+            if (next_position[machine] == static_cast<int>(sequences[machine].size())) continue;
+            int job = sequences[machine][next_position[machine]];
+            int index = next_operation[job];
+            if (index == problem.machineCount || problem.jobs[job][index].machine != machine) continue;
+            int start = std::max({job_end[job], machine_end[machine], problem.release[job][index]});
+            job_end[job] = machine_end[machine] = start + problem.jobs[job][index].duration;
+            objective = std::max(objective, job_end[job] + problem.delivery[job][index]);
+            ++next_operation[job];
+            ++next_position[machine];
+            ++scheduled;
+            progress = true;
+        }
+        if (!progress) return std::numeric_limits<int>::max();
+    }
+    return objective;
+}
+
+// enumeration of all machine sequences
+int enumerateOptimum(BranchAndBoundProblem const &problem, vector<vector<int>> &sequences, int machine) {
+    if (machine == problem.machineCount) return problemObjective(problem, sequences);
+    auto &sequence = sequences[machine];
+    std::iota(sequence.begin(), sequence.end(), 0);
+    int best = std::numeric_limits<int>::max();
+    do {
+        best = std::min(best, enumerateOptimum(problem, sequences, machine + 1));
+    } while (std::next_permutation(sequence.begin(), sequence.end()));
+    return best;
+}
+
+// random 4x3 problems with release and delivery times against the enumeration
+void checkSubproblems() {
+    auto rng = std::mt19937(1);
+    int job_count = 4, machine_count = 3;
+    for (int round = 0; round < 20; round++) {
+        BranchAndBoundProblem problem;
+        problem.machineCount = machine_count;
+        problem.release = problem.delivery = vector<vector<int>>(job_count, vector<int>(machine_count));
+        for (int job = 0; job < job_count; job++) {
+            auto machines = vector<int>(machine_count);
+            std::iota(machines.begin(), machines.end(), 0);
+            std::shuffle(machines.begin(), machines.end(), rng);
+            problem.jobs.emplace_back();
+            for (int index = 0; index < machine_count; index++) {
+                problem.jobs[job].push_back({machines[index], std::uniform_int_distribution<int>(1, 9)(rng), job});
+                if (round % 2 == 1) {
+                    problem.release[job][index] = std::uniform_int_distribution<int>(0, 15)(rng);
+                    problem.delivery[job][index] = std::uniform_int_distribution<int>(0, 15)(rng);
+                }
+            }
+        }
+        auto sequences = vector<vector<int>>(machine_count, vector<int>(job_count));
+        int optimum = enumerateOptimum(problem, sequences, 0);
+        auto result = BranchAndBound(problem).solve();
+        CHECK(result.optimal && result.solution.makespan == optimum && result.lowerBound == optimum);
+        CHECK(problemObjective(problem, result.solution.solution) == result.solution.makespan);
+    }
+}
+
+int main() {
+    checkOptimum("ft", "ft06", 55);
+    checkOptimum("la", "la01", 666);
+    checkSubproblems();
+    return checkResult();
+}
@@ -0,0 +1,134 @@
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include "check.h"
+#include "heuristics.h"
+
+// random solutions are feasible and active, see RandomScheduler
+void checkRandomScheduler(JSSPInstance &instance) {
+    auto scheduler = RandomScheduler(instance);
+    for (unsigned int seed = 0; seed < 30; seed++) {
+        auto rng = std::mt19937(seed);
+        auto solution = scheduler.schedule(rng);
+        auto starts = scheduleStarts(instance, solution);
+        CHECK(!starts.empty());
+        if (starts.empty()) continue;
+        CHECK(isActive(instance, solution, starts));
+        CHECK(scheduleMakespan(instance, starts) == instance.calcMakespan(solution));
+    }
+    for (auto const &solution: Heuristics::randomPopulation(instance, 8, 2)) {
+        auto starts = scheduleStarts(instance, solution.solution);
+        CHECK(!starts.empty() && scheduleMakespan(instance, starts) == solution.makespan);
+    }
+}
+
+/**
+ * whether a schedule is non delay: no machine is idle while an operation waits for it. An operation which is ready
+ * before the end of an idle interval of its machine (before its start) could have started in it
+ */
+bool isNonDelay(JSSPInstance const &instance, vector<vector<int>> const &solution, vector<vector<long long>> const &starts) {
+    auto operation_index = vector<vector<int>>(instance.jobCount, vector<int>(instance.machineCount));
+    for (int job = 0; job < instance.jobCount; job++) {
+        for (int i = 0; i < instance.machineCount; i++) operation_index[job][instance.instance[job][i].machine] = i;
+    }
+    for (int machine = 0; machine < instance.machineCount; machine++) {
+        for (size_t k = 0; k < solution[machine].size(); k++) {
+            int job = solution[machine][k];
+            int index = operation_index[job][machine];
+            long long ready = index == 0 ? 0 : starts[job][index - 1] + instance.instance[job][index - 1].duration;
+            long long idle_start = 0;
+            for (size_t g = 0; g < k; g++) {
+                int other = solution[machine][g];
+                int other_index = operation_index[other][machine];
+                if (idle_start < starts[other][other_index] && ready < starts[other][other_index]) return false;
+                idle_start = starts[other][other_index] + instance.instance[other][other_index].duration;
+            }
+        }
+    }
+    return true;
+}
+
+// the dispatching rules and their mixtures create feasible non delay solutions
+void checkDispatching(JSSPInstance &instance) {
+    auto solutions = vector<vector<vector<int>>>();
+    for (int rule = 0; rule < dispatchingRuleCount; rule++) {
+        solutions.emplace_back(Heuristics::dispatch(instance, static_cast<DispatchingRule>(rule)));
+    }
+    for (int round = 0; round < 10; round++) solutions.emplace_back(Heuristics::randomRuleMixture(instance));
+    for (auto const &solution: solutions) {
+        auto starts = scheduleStarts(instance, solution);
+        CHECK(!starts.empty());
+        if (starts.empty()) continue;
+        CHECK(isNonDelay(instance, solution, starts));
+        CHECK(scheduleMakespan(instance, starts) == instance.calcMakespan(solution));
+    }
+    for (auto const &solution: Heuristics::population(instance, 12)) {
+        auto starts = scheduleStarts(instance, solution.solution);
+        CHECK(!starts.empty() && scheduleMakespan(instance, starts) == solution.makespan);
+    }
+}
+
+// max(C_j + q_j) of a sequence on one machine
+long long singleMachineValue(vector<long long> const &release, vector<long long> const &duration,
+                             vector<long long> const &delivery, vector<int> const &sequence) {
+    long long time = 0, value = 0;
+    for (int job: sequence) {
+        time = std::max(time, release[job]) + duration[job];
+        value = std::max(value, time + delivery[job]);
+    }
+    return value;
+}
+
+// Carlier's branch and bound against the enumeration of all sequences, Schrage's rule is never better
+void checkSingleMachineSolver() {
+    auto rng = std::mt19937(1);
+    auto solver = SingleMachineSolver();
+    for (int round = 0; round < 300; round++) {
+        int job_count = 1 + round % 7;
+        auto release = vector<long long>(job_count), duration = vector<long long>(job_count), delivery = vector<long long>(job_count);
+        for (int job = 0; job < job_count; job++) {
+            release[job] = std::uniform_int_distribution<int>(0, 30)(rng);
+            duration[job] = std::uniform_int_distribution<int>(1, 10)(rng);
+            delivery[job] = std::uniform_int_distribution<int>(0, 30)(rng);
+        }
+        auto permutation = vector<int>(job_count);
+        std::iota(permutation.begin(), permutation.end(), 0);
+        long long optimum = singleMachineValue(release, duration, delivery, permutation);
+        while (std::next_permutation(permutation.begin(), permutation.end())) {
+            optimum = std::min(optimum, singleMachineValue(release, duration, delivery, permutation));
+        }
+        auto sequence = vector<int>();
+        long long value = solver.solve(release, duration, delivery, sequence, 100000);
+        CHECK(value == optimum);
+        auto sorted = sequence;
+        std::sort(sorted.begin(), sorted.end());
+        CHECK(sorted == permutation);
+        CHECK(singleMachineValue(release, duration, delivery, sequence) == value);
+        long long schrage_value = solver.solve(release, duration, delivery, sequence, 1);
+        CHECK(schrage_value >= optimum && singleMachineValue(release, duration, delivery, sequence) == schrage_value);
+    }
+}
+
+// the shifting bottleneck solution is feasible and its makespan is the one of its schedule
+void checkShiftingBottleneck(JSSPInstance const &instance, int optimum) {
+    auto result = Heuristics::shiftingBottleneck(instance);
+    auto starts = scheduleStarts(instance, result.solution);
+    CHECK(!starts.empty());
+    if (starts.empty()) return;
+    CHECK(scheduleMakespan(instance, starts) == result.makespan);
+    CHECK(result.makespan >= optimum);
+}
+
+int main() {
+    checkSingleMachineSolver();
+    // optimal makespans from the literature
+    for (auto [set, name, optimum]: vector<std::tuple<string, string, int>>{{"ft", "ft06", 55}, {"ft", "ft10", 930},
+                                                                            {"la", "la24", 935}, {"abz", "abz7", 656}}) {
+        string path = instancePath(set, name);
+        JSSPInstance instance(path, 1);
+        checkRandomScheduler(instance);
+        checkDispatching(instance);
+        checkShiftingBottleneck(instance, optimum);
+    }
+    return checkResult();
+}
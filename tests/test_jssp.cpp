@@ -0,0 +1,129 @@
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <tuple>
+#include "check.h"
+#include "jssp.h"
+#include "heuristics.h"
+
+// the flat solution converts back to the same machine sequences and has the makespan of the nested one
+void checkFlatSolution(JSSPInstance &instance) {
+    for (int round = 0; round < 20; round++) {
+        auto nested = Heuristics::randomRuleMixture(instance);
+        auto flat = FlatSolution(nested, 7);
+        CHECK(flat.machineCount() == instance.machineCount && flat.stride == instance.jobCount);
+        CHECK(flat.toNested() == nested);
+        CHECK(flat.toSolution().makespan == 7);
+        CHECK(instance.calcMakespan(flat) == instance.calcMakespan(nested));
+        auto narrow = BasicFlatSolution<uint8_t, uint16_t>(nested);
+        CHECK(instance.calcMakespan(narrow) == instance.calcMakespan(nested));
+    }
+}
+
+// both child repairs turn random machine sequences into feasible solutions, the decoder into active ones. An active
+// solution is decoded into itself
+void checkChildRepair(JSSPInstance &instance) {
+    auto rng = std::mt19937(1);
+    auto scheduler = RandomScheduler(instance);
+    for (int round = 0; round < 30; round++) {
+        auto shuffled = FlatSolution(instance.machineCount, instance.jobCount);
+        for (int machine = 0; machine < instance.machineCount; machine++) {
+            auto begin = shuffled.sequence.begin() + machine * instance.jobCount;
+            std::iota(begin, begin + instance.jobCount, 0);
+            std::shuffle(begin, begin + instance.jobCount, rng);
+        }
+        auto repaired = shuffled;
+        int makespan = instance.calcMakespanAndFixSolution(repaired, round);
+        auto starts = scheduleStarts(instance, repaired.toNested());
+        CHECK(!starts.empty() && scheduleMakespan(instance, starts) == makespan);
+
+        auto decoded = shuffled;
+        makespan = instance.decodeActiveSchedule(decoded);
+        starts = scheduleStarts(instance, decoded.toNested());
+        CHECK(!starts.empty());
+        if (starts.empty()) continue;
+        CHECK(scheduleMakespan(instance, starts) == makespan);
+        CHECK(isActive(instance, decoded.toNested(), starts));
+
+        auto active = FlatSolution(scheduler.schedule(rng));
+        decoded = active;
+        makespan = instance.decodeActiveSchedule(decoded);
+        CHECK(decoded.sequence == active.sequence && makespan == instance.calcMakespan(active));
+    }
+}
+
+// Jackson's preemptive schedule lies between the simple machine bounds and the non preemptive optimum (enumeration)
+void checkPreemptiveBound() {
+    auto rng = std::mt19937(1);
+    for (int round = 0; round < 300; round++) {
+        int count = 1 + round % 6;
+        auto operations = vector<std::tuple<int, int, int>>(count);
+        for (auto &[head, duration, tail]: operations) {
+            head = std::uniform_int_distribution<int>(0, 30)(rng);
+            duration = std::uniform_int_distribution<int>(1, 10)(rng);
+            tail = std::uniform_int_distribution<int>(0, 30)(rng);
+        }
+        int min_head = std::get<0>(operations[0]), min_tail = std::get<2>(operations[0]), load = 0, longest = 0;
+        for (auto [head, duration, tail]: operations) {
+            min_head = std::min(min_head, head);
+            min_tail = std::min(min_tail, tail);
+            load += duration;
+            longest = std::max(longest, head + duration + tail);
+        }
+        auto order = vector<int>(count);
+        std::iota(order.begin(), order.end(), 0);
+        int optimum = std::numeric_limits<int>::max();
+        do {
+            int time = 0, value = 0;
+            for (int i: order) {
+                time = std::max(time, std::get<0>(operations[i])) + std::get<1>(operations[i]);
+                value = std::max(value, time + std::get<2>(operations[i]));
+            }
+            optimum = std::min(optimum, value);
+        } while (std::next_permutation(order.begin(), order.end()));
+
+        int bound = preemptiveOneMachineBound(operations);
+        CHECK(bound >= min_head + load + min_tail && bound >= longest);
+        CHECK(bound <= optimum);
+    }
+}
+
+// the lower bound of an instance is at least the job and machine work, at most the optimum, and follows setDuration
+void checkLowerBound(JSSPInstance &instance, int optimum) {
+    CHECK(instance.lowerBound() <= optimum);
+    auto machine_work = vector<int>(instance.machineCount);
+    for (auto const &job: instance.instance) {
+        int job_work = 0;
+        for (auto const &operation: job) {
+            job_work += operation.duration;
+            machine_work[operation.machine] += operation.duration;
+        }
+        CHECK(instance.lowerBound() >= job_work);
+    }
+    CHECK(instance.lowerBound() >= *std::max_element(machine_work.begin(), machine_work.end()));
+
+    auto jobs = instance.instance;
+    int duration = jobs[0][0].duration;
+    instance.setDuration(0, 0, duration + 1000);
+    jobs[0][0].duration = duration + 1000;
+    CHECK(instance.lowerBound() == JSSPInstance(jobs, 1).lowerBound());
+    instance.setDuration(0, 0, duration);
+    CHECK(instance.lowerBound() <= optimum);
+}
+
+int main() {
+    string path = instancePath("ft", "ft10");
+    JSSPInstance instance(path, 1);
+    checkFlatSolution(instance);
+    checkChildRepair(instance);
+    checkPreemptiveBound();
+    // optimal makespans from the literature
+    for (auto [set, name, optimum]: vector<std::tuple<string, string, int>>{{"ft", "ft06", 55}, {"ft", "ft10", 930},
+                                                                            {"la", "la24", 935}, {"abz", "abz7", 656}}) {
+        string optimum_path = instancePath(set, name);
+        JSSPInstance optimum_instance(optimum_path, 1);
+        checkLowerBound(optimum_instance, optimum);
+    }
+    return checkResult();
+}
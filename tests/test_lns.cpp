@@ -0,0 +1,31 @@
+#include "check.h"
+#include "lns.h"
+#include "heuristics.h"
+
+// the windows are applied only if the makespan does not get worse, the result has an exact makespan
+void checkLargeNeighbourhoodSearch(string path) {
+    JSSPInstance instance(path, 1);
+    auto start = Solution{Heuristics::dispatch(instance, spt), 0};
+    start.makespan = instance.calcMakespan(start.solution);
+    for (unsigned int threads: {1u, 2u}) {
+        auto lns = LargeNeighbourhoodSearch(instance);
+        lns.setWindow(30, 200, 0.3);
+        lns.setThreads(threads);
+        auto result = lns.optimize_it(start, 20);
+        auto starts = scheduleStarts(instance, result.solution);
+        CHECK(!starts.empty());
+        if (starts.empty()) continue;
+        CHECK(scheduleMakespan(instance, starts) == result.makespan);
+        CHECK(result.makespan <= start.makespan);
+        auto const &statistics = lns.statistics();
+        CHECK(statistics.windows > 0 && statistics.accepted <= statistics.windows);
+        // spt is far from a local optimum
+        CHECK(statistics.improved > 0 && result.makespan < start.makespan);
+    }
+}
+
+int main() {
+    checkLargeNeighbourhoodSearch(instancePath("la", "la24"));
+    checkLargeNeighbourhoodSearch(instancePath("swv", "swv01"));
+    return checkResult();
+}
@@ -0,0 +1,200 @@
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <new>
+#include <atomic>
+#include <cstdlib>
+#include "check.h"
+#include "mem.h"
+#include "solution_cache.h"
+
+using EngineL = MemeticEngine<Layout<int32_t, int32_t>>;
+
+// allocations of the process, see checkSteadyState
+std::atomic<long> allocationCount{0};
+
+void *operator new(std::size_t size) {
+    ++allocationCount;
+    if (void *memory = std::malloc(size > 0 ? size : 1)) return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept { std::free(memory); }
+
+void operator delete(void *memory, std::size_t) noexcept { std::free(memory); }
+
+// length of the longest common subsequence by dynamic programming, the implementation LIS replaced
+int lcsLengthDP(vector<int> const &machine_1, vector<int> const &machine_2) {
+    size_t n = machine_1.size();
+    auto table = vector<vector<int>>(n + 1, vector<int>(n + 1));
+    for (size_t i = 1; i <= n; i++) {
+        for (size_t j = 1; j <= n; j++) {
+            table[i][j] = machine_1[i - 1] == machine_2[j - 1] ? table[i - 1][j - 1] + 1
+                                                                : std::max(table[i - 1][j], table[i][j - 1]);
+        }
+    }
+    return table[n][n];
+}
+
+// sequence is a subsequence of machine
+bool isSubsequence(std::pmr::vector<int> const &sequence, vector<int> const &machine) {
+    size_t next = 0;
+    for (int job: machine) {
+        if (next < sequence.size() && sequence[next] == job) ++next;
+    }
+    return next == sequence.size();
+}
+
+struct MemeticCheck {
+    // the longest common sequence via the longest increasing subsequence has the length of the dynamic program and
+    // is a subsequence of both machines
+    static void longestCommonSequence() {
+        std::mt19937 rng(3);
+        for (int n: {1, 2, 5, 10, 20, 50, 100}) {
+            for (int round = 0; round < 50; round++) {
+                auto machine_1 = vector<int>(n);
+                std::iota(machine_1.begin(), machine_1.end(), 0);
+                auto machine_2 = machine_1;
+                std::shuffle(machine_1.begin(), machine_1.end(), rng);
+                std::shuffle(machine_2.begin(), machine_2.end(), rng);
+                // partly sorted, so long common sequences occur as well
+                if (round % 2 == 0) std::sort(machine_2.begin(), machine_2.begin() + n / 2);
+                int expected = lcsLengthDP(machine_1, machine_2);
+                auto lcs = EngineL::findLongestCommonSequence(machine_1.data(), machine_2.data(), n);
+                CHECK(static_cast<int>(lcs.size()) == expected);
+                CHECK(isSubsequence(lcs, machine_1) && isSubsequence(lcs, machine_2));
+                CHECK(EngineL::lcsLength(machine_1.data(), machine_2.data(), n) == expected);
+            }
+        }
+    }
+
+    // number of job pairs ordered equally on the same machine, counted pair by pair
+    static int equallyOrderedPairs(EngineL::FlatSolutionT const &solution_1, EngineL::FlatSolutionT const &solution_2) {
+        int n = solution_1.stride;
+        int count = 0;
+        auto position_1 = vector<int>(n), position_2 = vector<int>(n);
+        for (int machine = 0; machine < solution_1.machineCount(); machine++) {
+            for (int i = 0; i < n; i++) {
+                position_1[solution_1.machine(machine)[i]] = i;
+                position_2[solution_2.machine(machine)[i]] = i;
+            }
+            for (int a = 0; a < n; a++) {
+                for (int b = a + 1; b < n; b++) count += (position_1[a] < position_1[b]) == (position_2[a] < position_2[b]);
+            }
+        }
+        return count;
+    }
+
+    // the incrementally kept similarity matrix equals a full recomputation after each generation, the precedence
+    // similarity equals the pairwise count
+    static void similarityMatrix(JSSPInstance &instance, DiversityMetric metric) {
+        EngineL engine(instance, 12, 300, 0.8);
+        engine.setThreads(1);
+        engine.setDiversityMetric(metric);
+        engine.start({}, 0);
+        engine.step(12, 0);
+        for (int generation = 0; generation < 30; generation++) {
+            engine.step(1, 0);
+            CHECK(engine.similarityRows == engine.populationCount);
+            int wrong = 0;
+            for (int i = 0; i < engine.populationCount; i++) {
+                for (int j = 0; j < engine.populationCount; j++) {
+                    if (i == j) continue;
+                    if (engine.similarity(i, j) != engine.calcSimilarity(i, j)) ++wrong;
+                    if (metric == precedence_distance &&
+                        engine.similarity(i, j) != equallyOrderedPairs(engine.population[i], engine.population[j])) ++wrong;
+                }
+            }
+            CHECK(wrong == 0);
+        }
+    }
+};
+
+// the fingerprint cache answers only for the solution it stored, a fingerprint collision is a miss
+void checkSolutionCache() {
+    using FlatSolutionT = BasicFlatSolution<int32_t, int32_t>;
+    auto makeSolution = [](int first, int makespan) {
+        FlatSolutionT solution;
+        solution.sequence = {first, 1, 2, 3, 4, 5};
+        solution.stride = 3;
+        solution.makespan = makespan;
+        return solution;
+    };
+    BasicSolutionCache<int32_t, int32_t> cache;
+    FlatSolutionT child = makeSolution(0, 0), other = makeSolution(9, 0), optimum = makeSolution(7, 42), target;
+
+    cache.reset(0, 6);
+    cache.insert(1, child, optimum);
+    CHECK(!cache.find(1, child, target));
+
+    cache.reset(2, 6);
+    CHECK(!cache.find(1, child, target));
+    cache.insert(1, child, optimum);
+    CHECK(cache.find(1, child, target));
+    CHECK(target.sequence == optimum.sequence && target.makespan == 42 && target.stride == 3);
+    // same fingerprint, other child
+    CHECK(!cache.find(1, other, target));
+    // replaces the entry of the same fingerprint
+    cache.insert(1, other, child);
+    CHECK(cache.size() == 1);
+    CHECK(!cache.find(1, child, target));
+    CHECK(cache.find(1, other, target) && target.sequence == child.sequence);
+    // cleared when full
+    cache.insert(2, child, optimum);
+    CHECK(cache.size() == 2);
+    cache.insert(3, child, optimum);
+    CHECK(cache.size() == 1);
+    CHECK(!cache.find(1, other, target));
+    CHECK(cache.find(3, child, target));
+}
+
+// after the first generations a generation does not allocate, with each option of the main loop
+void checkSteadyState(JSSPInstance &instance) {
+    for (int option = 0; option < 5; option++) {
+        EngineL engine(instance, 12, 300, 0.8);
+        engine.setThreads(1);
+        if (option == 1) engine.setRecombinationOperator(path_relinking);
+        if (option == 2) engine.setChildRepair(active_decoding);
+        if (option == 3) engine.setDuplicateFilter(2, 64);
+        if (option == 4) {
+            engine.setDiversityMetric(precedence_distance);
+            engine.setAdaptiveBudget(true);
+        }
+        engine.start({}, 0);
+        engine.step(12 + 40, 0);
+        long before = allocationCount;
+        engine.step(20, 0);
+        long allocations = allocationCount - before;
+        CHECK(allocations == 0);
+        if (allocations != 0) std::cerr << "option " << option << ": " << allocations << " allocations" << std::endl;
+    }
+}
+
+// the adaptive budget is off by default, with it a run still reports a consistent best solution
+void checkAdaptiveBudget(JSSPInstance &instance) {
+    auto bests = vector<Solution>();
+    for (int option = 0; option < 3; option++) {
+        string path = instance.filename;
+        JSSPInstance run_instance(path, 1);
+        EngineL engine(run_instance, 12, 300, 0.8);
+        engine.setThreads(1);
+        if (option > 0) engine.setAdaptiveBudget(option == 2);
+        engine.start({}, 0);
+        engine.step(12 + 30, 0);
+        bests.push_back(engine.best());
+        CHECK(bests.back().makespan == instance.calcMakespan(bests.back().solution));
+    }
+    CHECK(bests[0].solution == bests[1].solution && bests[0].makespan == bests[1].makespan);
+}
+
+int main() {
+    string path = instancePath("ft", "ft10");
+    JSSPInstance instance(path, 1);
+    checkSolutionCache();
+    MemeticCheck::longestCommonSequence();
+    MemeticCheck::similarityMatrix(instance, lcs_similarity);
+    MemeticCheck::similarityMatrix(instance, precedence_distance);
+    checkSteadyState(instance);
+    checkAdaptiveBudget(instance);
+    return checkResult();
+}
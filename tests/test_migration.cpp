@@ -0,0 +1,71 @@
+#include <random>
+#include <algorithm>
+#include "check.h"
+#include "mem.h"
+#include "island.h"
+
+// island messages: round trip, and malformed counts give the complete solutions before the defect
+void checkMessages() {
+    auto solutions = vector<Solution>{Solution{{{0, 1}, {1, 0}}, 7}, Solution{{{1, 0}, {0, 1}}, 8}};
+    auto message = IslandModel::serialize(solutions);
+    auto received = IslandModel::deserialize(message.data(), message.size());
+    CHECK(received.size() == 2);
+    CHECK(received.size() == 2 && received[1].solution == solutions[1].solution && received[1].makespan == 8);
+
+    auto defect = message;
+    defect[2] = -5;
+    CHECK(IslandModel::deserialize(defect.data(), defect.size()).empty());
+    defect = message;
+    defect[2] = 1 << 30;
+    CHECK(IslandModel::deserialize(defect.data(), defect.size()).empty());
+    defect = message;
+    defect[3] = -1;
+    CHECK(IslandModel::deserialize(defect.data(), defect.size()).empty());
+    defect = message;
+    defect[10] = -3;
+    CHECK(IslandModel::deserialize(defect.data(), defect.size()).size() == 1);
+    CHECK(IslandModel::deserialize(message.data(), message.size() - 1).size() == 1);
+}
+
+// malformed immigrants are dropped and the makespan of the sender is not trusted
+void checkImmigrants() {
+    string path = instancePath("ft", "ft06");
+    JSSPInstance instance(path, 1);
+    std::mt19937 rng(5);
+    auto exchange = [&](vector<Solution> const &elite) {
+        auto immigrants = vector<Solution>();
+        // a well-formed copy of the elite which claims a makespan below the optimum
+        immigrants.emplace_back(Solution{elite.front().solution, 1});
+        auto ragged = elite.front();
+        ragged.solution[2].pop_back();
+        immigrants.emplace_back(ragged);
+        auto out_of_range = elite.front();
+        out_of_range.solution[1][0] = instance.jobCount;
+        out_of_range.makespan = 1;
+        immigrants.emplace_back(out_of_range);
+        auto duplicate = elite.front();
+        duplicate.solution[0][0] = duplicate.solution[0][1];
+        duplicate.makespan = 1;
+        immigrants.emplace_back(duplicate);
+        // random machine sequences, usually with a cycle
+        auto random = elite.front();
+        for (auto &machine: random.solution) std::shuffle(machine.begin(), machine.end(), rng);
+        random.makespan = 1;
+        immigrants.emplace_back(random);
+        return immigrants;
+    };
+    MemeticAlgorithm memetic(instance);
+    memetic.setThreads(1);
+    memetic.setMigration(1, 2, exchange);
+    memetic.start();
+    memetic.step(40);
+    auto result = memetic.finish();
+    CHECK(result.makespan >= 55);
+    CHECK(result.makespan == instance.calcMakespan(result.solution));
+}
+
+int main() {
+    checkMessages();
+    checkImmigrants();
+    return checkResult();
+}
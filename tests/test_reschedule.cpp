@@ -0,0 +1,129 @@
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include "check.h"
+#include "reschedule.h"
+#include "heuristics.h"
+
+/**
+ * start times of the session's sequences computed from scratch in topological order: operations which started before
+ * the clock keep their start time, all others start as early as their job and machine predecessors, the clock and the
+ * machine blocks in front of them allow
+ * @return start time of each operation (id job * #machines + index), empty if the sequences contain a cycle
+ */
+vector<int> recomputeStarts(Rescheduler const &session) {
+    auto const &instance = session.instance();
+    int job_count = instance.jobCount, machine_count = instance.machineCount;
+    auto const &reported = session.startTimes();
+    auto sequences = session.solution().solution;
+    auto starts = vector<int>(job_count * machine_count);
+    auto next_operation = vector<int>(job_count), next_position = vector<int>(machine_count);
+    auto job_end = vector<int>(job_count), machine_end = vector<int>(machine_count);
+    for (int scheduled = 0; scheduled < job_count * machine_count;) {
+        bool progress = false;
+        for (int machine = 0; machine < machine_count; machine++) {
+            int position = next_position[machine];
+            if (position == job_count) continue;
+            int job = sequences[machine][position];
+            int index = next_operation[job];
+            if (index == machine_count || instance.instance[job][index].machine != machine) continue;
+            int op = job * machine_count + index;
+            int start = std::max(job_end[job], machine_end[machine]);
+            if (reported[op] < session.now()) {
+                // started, fixed
+                start = reported[op];
+            } else {
+                start = std::max(start, session.now());
+                for (auto const &block: session.blocks()) {
+                    if (block.machine == machine && block.position <= position) start = std::max(start, block.to);
+                }
+            }
+            starts[op] = start;
+            job_end[job] = machine_end[machine] = start + instance.instance[job][index].duration;
+            ++next_operation[job];
+            ++next_position[machine];
+            ++scheduled;
+            progress = true;
+        }
+        if (!progress) return {};
+    }
+    return starts;
+}
+
+// the incrementally repaired schedule equals the recomputed one, respects the blocks and has the reported makespan
+void checkSchedule(Rescheduler const &session) {
+    auto const &instance = session.instance();
+    auto starts = recomputeStarts(session);
+    CHECK(!starts.empty());
+    if (starts.empty()) return;
+    CHECK(starts == session.startTimes());
+    int machine_count = instance.machineCount, makespan = 0;
+    auto sequences = session.solution().solution;
+    for (int job = 0; job < instance.jobCount; job++) {
+        for (int index = 0; index < machine_count; index++) {
+            makespan = std::max(makespan, starts[job * machine_count + index] + instance.instance[job][index].duration);
+        }
+    }
+    CHECK(makespan == session.solution().makespan);
+    for (auto const &block: session.blocks()) {
+        for (int position = 0; position < block.position; position++) {
+            int job = sequences[block.machine][position];
+            int index = 0;
+            while (instance.instance[job][index].machine != block.machine) ++index;
+            int end = starts[job * machine_count + index] + instance.instance[job][index].duration;
+            // operations in front of a block end before it, unless they started before the clock
+            CHECK(end <= block.from || starts[job * machine_count + index] < session.now());
+        }
+    }
+}
+
+// random shop events on random instances, the schedule is checked after each event
+void checkEvents() {
+    for (int trial = 0; trial < 60; trial++) {
+        auto rng = std::mt19937(trial);
+        int job_count = 5 + static_cast<int>(rng() % 15), machine_count = 3 + static_cast<int>(rng() % 10);
+        auto random_job = [&rng, machine_count](int job) {
+            auto machines = vector<int>(machine_count);
+            std::iota(machines.begin(), machines.end(), 0);
+            std::shuffle(machines.begin(), machines.end(), rng);
+            auto operations = vector<Operation>();
+            for (int machine: machines) operations.push_back(Operation{machine, static_cast<int>(1 + rng() % 50), job});
+            return operations;
+        };
+        auto jobs = vector<vector<Operation>>();
+        for (int job = 0; job < job_count; job++) jobs.emplace_back(random_job(job));
+        JSSPInstance instance(jobs, 7);
+        auto start = Solution{Heuristics::randomRuleMixture(instance), 0};
+        start.makespan = instance.calcMakespan(start.solution);
+        Rescheduler session(instance, start);
+        checkSchedule(session);
+        for (int event = 0; event < 40; event++) {
+            int kind = static_cast<int>(rng() % 6);
+            int jobs_now = session.instance().jobCount;
+            if (kind == 0) {
+                session.advance(session.now() + static_cast<int>(rng() % 60));
+            } else if (kind == 1) {
+                int job = static_cast<int>(rng() % jobs_now), index = static_cast<int>(rng() % machine_count);
+                int op = job * machine_count + index;
+                // a running or later operation, finished ones are history
+                if (session.startTimes()[op] + session.instance().instance[job][index].duration > session.now()) {
+                    session.changeDuration(job, index, static_cast<int>(rng() % 80));
+                }
+            } else if (kind == 2 || kind == 3) {
+                int machine = static_cast<int>(rng() % machine_count);
+                int from = session.now() + static_cast<int>(rng() % 200);
+                session.blockMachine(machine, from, from + 1 + static_cast<int>(rng() % 100));
+            } else if (kind == 4 && jobs_now < 30) {
+                CHECK(session.addJob(random_job(0)) == jobs_now);
+            } else {
+                session.optimize_it(200);
+            }
+            checkSchedule(session);
+        }
+    }
+}
+
+int main() {
+    checkEvents();
+    return checkResult();
+}
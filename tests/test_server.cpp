@@ -0,0 +1,101 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+#include "check.h"
+#include "server.h"
+
+/**
+ * serve the requests as stdin / stdout client: both are redirected to temporary files while the server runs. The
+ * server is destroyed before the answers are read, so the queued requests are answered
+ * @return answer lines
+ */
+vector<string> serveRequests(string const &requests) {
+    FILE *input = std::tmpfile(), *output = std::tmpfile();
+    std::fputs(requests.c_str(), input);
+    std::fflush(input);
+    std::rewind(input);
+    std::fflush(stdout);
+    int saved_in = dup(STDIN_FILENO), saved_out = dup(STDOUT_FILENO);
+    dup2(fileno(input), STDIN_FILENO);
+    dup2(fileno(output), STDOUT_FILENO);
+    {
+        SolverServer server(1);
+        server.serveStream();
+    }
+    std::fflush(stdout);
+    dup2(saved_in, STDIN_FILENO);
+    dup2(saved_out, STDOUT_FILENO);
+    close(saved_in);
+    close(saved_out);
+
+    std::rewind(output);
+    auto lines = vector<string>();
+    string line;
+    char buffer[4096];
+    while (std::fgets(buffer, sizeof(buffer), output)) {
+        line += buffer;
+        if (line.back() != '\n') continue;
+        line.pop_back();
+        lines.push_back(line);
+        line.clear();
+    }
+    std::fclose(input);
+    std::fclose(output);
+    return lines;
+}
+
+// the answers of the requests of the protocol, see SolverServer
+void checkProtocol() {
+    string path = instancePath("ft", "ft06");
+    JSSPInstance instance(path, 1);
+    std::ifstream file(path);
+    std::stringstream instance_text;
+    instance_text << file.rdbuf();
+
+    auto lines = serveRequests("instance ft06\n" + instance_text.str() +
+                               "instance ragged\n2 2\n0 1 1 1\n0 1 0 1\n"
+                               "instance\n"
+                               "solve\n"
+                               "solve a ft06 xx 1\n"
+                               "solve b missing ts 1\n"
+                               "solve c ft06 ts 1 55\n"
+                               "unknown\n"
+                               "drop ft06\n"
+                               "quit\n"
+                               "solve d ft06 ts 1\n");
+    auto count = [&lines](string const &line) { return std::count(lines.begin(), lines.end(), line); };
+    CHECK(count("loaded ft06 " + std::to_string(instance.lowerBound())) == 1);
+    CHECK(count("error instance ragged: each job has to contain one operation for each machine") == 1);
+    CHECK(count("error instance without a name") == 1);
+    CHECK(count("error usage: solve <id> <name> <ts|mem> <seconds> [lower bound]") == 2);
+    CHECK(count("error unknown instance missing") == 1);
+    CHECK(count("error unknown request unknown") == 1);
+    CHECK(count("dropped ft06") == 1);
+
+    // the solution of c, nothing of d after quit
+    auto solution_line = std::find_if(lines.begin(), lines.end(), [](string const &line) { return line.rfind("solution ", 0) == 0; });
+    CHECK(solution_line != lines.end());
+    if (solution_line == lines.end()) return;
+    CHECK(std::count_if(lines.begin(), lines.end(), [](string const &line) { return line.rfind("solution ", 0) == 0; }) == 1);
+    std::istringstream header(*solution_line);
+    string keyword, id;
+    int makespan = 0;
+    header >> keyword >> id >> makespan;
+    CHECK(id == "c" && makespan >= 55);
+    CHECK(lines.end() - solution_line > instance.machineCount);
+    if (lines.end() - solution_line <= instance.machineCount) return;
+    auto solution = vector<vector<int>>(instance.machineCount);
+    for (int machine = 0; machine < instance.machineCount; machine++) {
+        std::istringstream row(*(solution_line + 1 + machine));
+        int job;
+        while (row >> job) solution[machine].push_back(job);
+    }
+    auto starts = scheduleStarts(instance, solution);
+    CHECK(!starts.empty() && scheduleMakespan(instance, starts) == makespan);
+}
+
+int main() {
+    checkProtocol();
+    return checkResult();
+}
@@ -0,0 +1,64 @@
+#include "check.h"
+#include "ts.h"
+#include "mem.h"
+#include "heuristics.h"
+
+// best solution of a tabu search run stepped in slices of the given number of iterations, on its own instance
+Solution tabuSearchSlices(string path, Solution const &start, long iterations, long slice) {
+    JSSPInstance instance(path, 1);
+    TabuSearch search(instance);
+    search.start(start);
+    for (long done = 0; done < iterations; done += slice) search.step(slice);
+    auto result = search.finish();
+    CHECK(result.makespan == search.best().makespan);
+    return search.best();
+}
+
+// best solution of a memetic run stepped in slices of the given number of iterations, on its own instance
+Solution memeticSlices(string path, long iterations, long slice) {
+    JSSPInstance instance(path, 1);
+    MemeticAlgorithm memetic(instance, 10, 500);
+    memetic.setThreads(1);
+    memetic.start();
+    for (long done = 0; done < iterations; done += slice) memetic.step(slice);
+    auto result = memetic.finish();
+    CHECK(result.makespan == memetic.best().makespan);
+    return memetic.best();
+}
+
+// the slices of a resumable run do not change its trajectory, and interleaved runs do not influence each other
+void checkSlices(string path) {
+    JSSPInstance instance(path, 1);
+    auto start = Solution{Heuristics::randomRuleMixture(instance), 0};
+    start.makespan = instance.calcMakespan(start.solution);
+
+    auto whole = tabuSearchSlices(path, start, 6000, 6000);
+    CHECK(whole.makespan == instance.calcMakespan(whole.solution) && whole.makespan <= start.makespan);
+    for (long slice: {1000, 7}) {
+        auto sliced = tabuSearchSlices(path, start, 6000, slice);
+        CHECK(sliced.solution == whole.solution && sliced.makespan == whole.makespan);
+    }
+
+    auto generations = memeticSlices(path, 60, 60);
+    CHECK(generations.makespan == instance.calcMakespan(generations.solution));
+    auto sliced = memeticSlices(path, 60, 4);
+    CHECK(sliced.solution == generations.solution && sliced.makespan == generations.makespan);
+
+    // two runs on one thread, alternating
+    JSSPInstance instance_1(path, 1), instance_2(path, 1);
+    TabuSearch search(instance_1);
+    MemeticAlgorithm memetic(instance_2, 10, 500);
+    memetic.setThreads(1);
+    search.start(start);
+    memetic.start();
+    for (int slice = 0; slice < 15; slice++) {
+        search.step(400);
+        memetic.step(4);
+    }
+    CHECK(search.best().solution == whole.solution && memetic.best().solution == generations.solution);
+}
+
+int main() {
+    checkSlices(instancePath("la", "la24"));
+    return checkResult();
+}
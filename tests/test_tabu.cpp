@@ -0,0 +1,222 @@
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include "check.h"
+#include "ts.h"
+#include "heuristics.h"
+
+using LayoutL = Layout<int32_t, int32_t>;
+using EngineL = TabuSearchEngine<LayoutL, N7Neighbourhood>;
+
+struct TabuSearchCheck {
+    // zobrist hash of the machine sequences, computed from scratch
+    static uint64_t rehash(EngineL const &engine) {
+        uint64_t hash = 0;
+        int job_count = engine.instance.jobCount;
+        for (int machine = 0; machine < engine.instance.machineCount; machine++) {
+            for (int i = 0; i < job_count; i++) {
+                hash ^= engine.zobristKeys[(machine * job_count + i) * job_count + engine.currentSolution.machine(machine)[i]];
+            }
+        }
+        return hash;
+    }
+
+    // the hash updated with each move equals a rehash of the current solution, with and without escape moves
+    static void zobristHash(JSSPInstance &instance) {
+        auto search = makeTabuSearch<LayoutL>(instance, n7);
+        auto *engine = dynamic_cast<EngineL *>(search.get());
+        CHECK(engine != nullptr);
+        if (engine == nullptr) return;
+        auto start = EngineL::FlatSolutionT(Heuristics::randomRuleMixture(instance));
+        for (int window: {0, 5}) {
+            engine->setCycleDetection(window, 2);
+            int wrong = 0;
+            for (long iterations = 1; iterations <= 300; iterations += 7) {
+                engine->optimize_it(start, iterations, 0);
+                if (engine->currentHash != rehash(*engine)) ++wrong;
+            }
+            CHECK(wrong == 0);
+        }
+        engine->setCycleDetection(5, 2);
+        engine->resetStatistics();
+        engine->optimize_it(start, 20000, 0);
+        // a window of 5 solutions is revisited on la24
+        CHECK(engine->statistics().escapes > 0);
+    }
+
+    // diversification only runs after setDiversification, and the best solution stays exact
+    static void diversification(JSSPInstance &instance) {
+        auto start = EngineL::FlatSolutionT(Heuristics::randomRuleMixture(instance));
+        for (bool enabled: {false, true}) {
+            auto search = makeTabuSearch<LayoutL>(instance, n7);
+            if (enabled) search->setDiversification(300, 20, 3);
+            search->start(start, 0);
+            search->step(5000, 0);
+            auto best = search->best();
+            CHECK(best.makespan == instance.calcMakespan(best.solution));
+            CHECK((search->statistics().perturbations > 0) == enabled);
+            CHECK((search->statistics().restarts > 0) == enabled);
+        }
+    }
+};
+
+// the elites stay mutually distant and the best solution offered stays in the archive
+void checkEliteArchive() {
+    using FlatSolutionT = BasicFlatSolution<int32_t, int32_t>;
+    std::mt19937 rng(1);
+    FlatSolutionT base;
+    base.stride = 10;
+    base.sequence.resize(40);
+    for (size_t i = 0; i < base.sequence.size(); i++) base.sequence[i] = static_cast<int>(i % 10);
+    for (int min_distance: {1, 3, 6}) {
+        BasicEliteArchive<int32_t, int32_t> archive(5, min_distance);
+        int best = 1 << 30;
+        for (int round = 0; round < 2000; round++) {
+            // a few swaps away from the base, so the offers are often close to elites
+            FlatSolutionT solution = base;
+            int swaps = std::uniform_int_distribution<int>(0, 3)(rng);
+            for (int k = 0; k < swaps; k++) {
+                int machine = std::uniform_int_distribution<int>(0, 3)(rng);
+                int i = std::uniform_int_distribution<int>(0, 9)(rng), j = std::uniform_int_distribution<int>(0, 9)(rng);
+                std::swap(solution.sequence[machine * 10 + i], solution.sequence[machine * 10 + j]);
+            }
+            solution.makespan = std::uniform_int_distribution<int>(100, 2000)(rng);
+            best = std::min(best, solution.makespan);
+            archive.insert(solution);
+            CHECK(archive.size() >= 1 && archive.size() <= 5);
+            int archive_best = archive[0].makespan;
+            for (int i = 0; i < archive.size(); i++) {
+                archive_best = std::min(archive_best, archive[i].makespan);
+                for (int j = i + 1; j < archive.size(); j++) {
+                    CHECK(sequenceDistance(archive[i], archive[j]) >= min_distance);
+                }
+            }
+            CHECK(archive_best == best);
+        }
+    }
+}
+
+// tabu search on the layout L from the start solution, each run with a new instance of the same seed
+template<typename L>
+Solution runOnLayout(string path, Solution const &start, long iterations) {
+    JSSPInstance instance(path, 1);
+    auto search = makeTabuSearch<L>(instance, n7);
+    return search->optimize_it(start, iterations, 0);
+}
+
+// the narrow id and time types search the same trajectory as the wide ones
+void checkLayouts(string path) {
+    JSSPInstance instance(path, 1);
+    auto start = Solution{Heuristics::randomRuleMixture(instance), 0};
+    auto wide = runOnLayout<Layout<int32_t, int32_t>>(path, start, 3000);
+    CHECK(wide.makespan == instance.calcMakespan(wide.solution));
+    auto narrow = runOnLayout<Layout<uint8_t, uint16_t>>(path, start, 3000);
+    CHECK(narrow.solution == wide.solution && narrow.makespan == wide.makespan);
+    auto medium = runOnLayout<Layout<uint16_t, int32_t>>(path, start, 3000);
+    CHECK(medium.solution == wide.solution && medium.makespan == wide.makespan);
+}
+
+// the engines with compile time dimensions search the same trajectory as the engine with runtime dimensions
+template<typename Shaped>
+void checkShape(string path) {
+    JSSPInstance instance(path, 1);
+    auto search = makeTabuSearch<Layout<typename Shaped::Index, typename Shaped::Time>>(instance, n7);
+    CHECK((dynamic_cast<TabuSearchEngine<Shaped, N7Neighbourhood> *>(search.get()) != nullptr));
+    auto start = Solution{Heuristics::randomRuleMixture(instance), 0};
+    auto runtime = runOnLayout<Layout<int32_t, int32_t>>(path, start, 3000);
+    auto shaped = runOnLayout<Layout<typename Shaped::Index, typename Shaped::Time>>(path, start, 3000);
+    CHECK(shaped.solution == runtime.solution && shaped.makespan == runtime.makespan);
+}
+
+// block orders the moves of a neighbourhood policy generate on one block, all moves allowed
+struct RecordedMoves {
+    int blockSize;
+    std::set<vector<int>> orders;
+
+    [[nodiscard]] bool canMoveForward(int, int) const { return true; };
+    [[nodiscard]] bool canMoveBackward(int, int) const { return true; };
+    void forward(int u, int v) { record(u, v + 1, u); };
+    void backward(int u, int v) { record(v, u, v); };
+
+    // moves the operation at from to insert before position to of the original block
+    void record(int from, int to, int operation) {
+        auto order = vector<int>(blockSize);
+        std::iota(order.begin(), order.end(), 0);
+        order.erase(order.begin() + from);
+        order.insert(order.begin() + (to > from ? to - 1 : to), operation);
+        orders.insert(order);
+    }
+};
+
+template<typename Neighbourhood>
+std::set<vector<int>> blockOrders(int block_size, bool path_start, bool path_end) {
+    auto moves = RecordedMoves{block_size, {}};
+    Neighbourhood::generate(moves, block_size, path_start, path_end);
+    return moves.orders;
+}
+
+// N5 and N6 are part of N7, and every neighbourhood finds a consistent solution not worse than the start
+void checkNeighbourhoods(JSSPInstance &instance) {
+    for (int block_size = 2; block_size <= 8; block_size++) {
+        for (bool path_start: {false, true}) {
+            for (bool path_end: {false, true}) {
+                auto n7_orders = blockOrders<N7Neighbourhood>(block_size, path_start, path_end);
+                auto identity = vector<int>(block_size);
+                std::iota(identity.begin(), identity.end(), 0);
+                CHECK(n7_orders.count(identity) == 0);
+                for (auto const &order: blockOrders<N5Neighbourhood>(block_size, path_start, path_end)) CHECK(n7_orders.count(order) == 1);
+                for (auto const &order: blockOrders<N6Neighbourhood>(block_size, path_start, path_end)) CHECK(n7_orders.count(order) == 1);
+            }
+        }
+    }
+    auto start = Solution{Heuristics::randomRuleMixture(instance), 0};
+    start.makespan = instance.calcMakespan(start.solution);
+    for (auto neighbourhood: {n5, n6, n7}) {
+        auto search = makeTabuSearch<LayoutL>(instance, neighbourhood);
+        auto result = search->optimize_it(start, 2000, 0);
+        CHECK(result.makespan == instance.calcMakespan(result.solution) && result.makespan <= start.makespan);
+    }
+}
+
+// number of machine sequence positions which hold different jobs
+int nestedDistance(vector<vector<int>> const &solution_1, vector<vector<int>> const &solution_2) {
+    int distance = 0;
+    for (size_t machine = 0; machine < solution_1.size(); machine++) {
+        for (size_t i = 0; i < solution_1[machine].size(); i++) distance += solution_1[machine][i] != solution_2[machine][i];
+    }
+    return distance;
+}
+
+// path relinking selects a feasible solution between the two, with exact makespan
+void checkRelink(JSSPInstance &instance) {
+    auto search = makeTabuSearch<LayoutL>(instance, n7);
+    for (int round = 0; round < 10; round++) {
+        auto initiating = Solution{Heuristics::randomRuleMixture(instance), 0};
+        auto guiding = Solution{Heuristics::random(instance), 0};
+        initiating.makespan = instance.calcMakespan(initiating.solution);
+        guiding.makespan = instance.calcMakespan(guiding.solution);
+        int distance = nestedDistance(initiating.solution, guiding.solution);
+        auto result = search->relink(initiating, guiding);
+        CHECK(result.makespan == instance.calcMakespan(result.solution));
+        CHECK(nestedDistance(result.solution, initiating.solution) < distance);
+        CHECK(nestedDistance(result.solution, guiding.solution) < distance);
+        auto same = search->relink(initiating, initiating);
+        CHECK(same.solution == initiating.solution && same.makespan == initiating.makespan);
+    }
+}
+
+int main() {
+    // 15 x 10, no specialised shape
+    string path = instancePath("la", "la24");
+    JSSPInstance instance(path, 1);
+    checkEliteArchive();
+    TabuSearchCheck::zobristHash(instance);
+    TabuSearchCheck::diversification(instance);
+    checkLayouts(path);
+    checkNeighbourhoods(instance);
+    checkRelink(instance);
+    checkShape<Layout<uint8_t, uint16_t, 10, 10>>(instancePath("ft", "ft10"));
+    checkShape<Layout<uint16_t, uint16_t, 20, 15>>(instancePath("abz", "abz7"));
+    return checkResult();
+}